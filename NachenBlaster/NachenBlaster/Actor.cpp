@@ -1,43 +1,66 @@
 #include "Actor.h"
 #include "StudentWorld.h"
 #include "GameConstants.h"
+#include "CollisionKernel.h"
+#include "WorldSnapshot.h"
+#include "GameRules.h"
 #include <math.h>
 #include <random>
 using namespace std;
 
-Actor::Actor(int imageID, double startX, double startY, int dir = 0, double size = 1.0, int depth = 0)
-: GraphObject(imageID,startX,startY,dir,size,depth), alive(true), m_tag(GAMEOBJECT), m_world(nullptr)
-{}
-
-//Overloaded constructor includes StudentWorld pointer
+//Actors are registered for drawing with their world's GraphObjectRegistry
 Actor::Actor(int imageID, double startX, double startY, StudentWorld* world, int dir = 0, double size = 1.0, int depth = 0)
-: GraphObject(imageID,startX,startY,dir,size,depth), alive(true), m_world(world), m_tag(GAMEOBJECT)
+: GraphObject(world->graphObjects(),imageID,startX,startY,dir,size,depth), alive(true), m_world(world), m_tag(GAMEOBJECT), m_layer(LAYER_NONE), m_hitMask(0), m_broadphaseSlot(-1), m_archetype(ARCH_NONE), m_slot(-1), m_spawnSeq(0), m_handle(NO_ACTOR)
 {}
 
 bool Actor::isAlive() const { return alive; }
-void Actor::die() { alive = false; }
 StudentWorld* Actor::getWorld() const { return m_world; }
 
-bool Actor::inBounds(double x, double y) const
+//die, moveTo and setSize keep the world's actor store and collision grid in step
+void Actor::die()
+{
+    alive = false;
+    if (m_slot >= 0)
+        m_world->actorChanged(this);
+}
+
+void Actor::moveTo(double x, double y)
+{
+    GraphObject::moveTo(x, y);
+    if (m_slot >= 0)
+        m_world->actorChanged(this);
+}
+
+void Actor::setSize(double size)
+{
+    GraphObject::setSize(size);
+    if (m_slot >= 0)
+        m_world->actorChanged(this);
+}
+
+int Actor::getBroadphaseSlot() const {return m_broadphaseSlot;}
+void Actor::setBroadphaseSlot(int slot) {m_broadphaseSlot = slot;}
+int Actor::getArchetype() const {return m_archetype;}
+void Actor::setArchetype(int archetype) {m_archetype = archetype;}
+int Actor::getSlot() const {return m_slot;}
+void Actor::setSlot(int slot) {m_slot = slot;}
+unsigned long Actor::getSpawnSeq() const {return m_spawnSeq;}
+void Actor::setSpawnSeq(unsigned long seq) {m_spawnSeq = seq;}
+ActorHandle Actor::getHandle() const {return m_handle;}
+void Actor::setHandle(ActorHandle handle) {m_handle = handle;}
+
+bool Actor::inBounds(double x, double y) const //compared where the actor would actually land, in fixed point
 {
-    if (x < 0 || x >= VIEW_WIDTH || y < 0 || y >= VIEW_HEIGHT) //outside of screen
+    const Fixed fx = toFixed(x);
+    const Fixed fy = toFixed(y);
+    if (fx < 0 || fx >= VIEW_WIDTH * FIXED_ONE || fy < 0 || fy >= VIEW_HEIGHT * FIXED_ONE) //outside of screen
         return false;
     return true;
 }
 
 bool Actor::collision(Actor* a2) const //checks if this Actor and Actor a2 collided
 {
-    double x1 = getX();
-    double y1 = getY();
-    double r1 = getRadius();
-    double x2 = a2->getX();
-    double y2 = a2->getY();
-    double r2 = a2->getRadius();
-    
-    double euclidian_dist = sqrt((x1-x2) * (x1-x2) + (y1-y2) * (y1-y2));
-    if (euclidian_dist < .75 * (r1+r2))
-        return true;
-    return false;
+    return circlesCollide(getFixedX(), getFixedY(), getFixedRadius(), a2->getFixedX(), a2->getFixedY(), a2->getFixedRadius());
 }
 
 //Each Actor has an identifier tag
@@ -50,47 +73,43 @@ bool Actor::isAlien(int tag) const
     return (tag == IID_SMALLGON || tag == IID_SMOREGON|| tag == IID_SNAGGLEGON);
 }
 
-//Overridden by Alien and Goodie derived classes
-void Actor::act(int tag) {}
-
 //Overridden by NachenBlaster and aliens from the Alien class, which are able to take damage through collisions
 void Actor::sufferDamage(int enemy) {}
-bool Actor::isCollidable(int enemy) const {return false;}
-
 
-//****** DERIVED CLASSES ******//
-
-Star::Star(double startX, double startY)
-: Actor(IID_STAR, startX, startY, 0, randDouble(.05, .5), 3) //randDouble is public function from StudentWorld.h/StudentWorld.cpp
-{}
-
-void Star::doSomething()
+//Fields every actor has; derived classes add their own
+void Actor::saveState(ActorState& s) const
 {
-    double x = getX();
-    double y = getY();
-    if (inBounds(x-1, y))
-        moveTo(x-1, y);
-    else
-        die();
+    s.x = getX();
+    s.y = getY();
+    s.size = getSize();
+    s.archetype = m_archetype;
+    s.tag = m_tag;
+    s.direction = getDirection();
+    s.spawnSeq = m_spawnSeq;
 }
 
-Explosion::Explosion(double startX, double startY)
-: Actor(IID_EXPLOSION, startX, startY), countdown(4)
-{}
+void Actor::loadState(const ActorState& s)
+{
+    moveTo(s.x, s.y);
+    setSize(s.size);
+    setDirection(s.direction);
+    m_spawnSeq = s.spawnSeq;
+}
 
-void Explosion::doSomething()
+//Collision layers (CollisionLayers.h) decide who can hit whom
+bool Actor::canBeHitBy(const Actor* a2) const {return (m_hitMask & a2->m_layer) != 0;}
+unsigned int Actor::getCollisionLayer() const {return m_layer;}
+unsigned int Actor::getHitMask() const {return m_hitMask;}
+void Actor::setCollisionLayer(unsigned int layer)
 {
-    setSize(getSize()*1.5);
-    if (countdown == 1) //removes from game after 4 ticks
-    {
-        die();
-        countdown = 4;
-    }
-    else
-        countdown--;
+    m_layer = layer;
+    m_hitMask = hitMaskFor(layer);
 }
 
 
+//****** DERIVED CLASSES ******//
+
+
 //****** DAMAGEABLE OBJECT CLASS ******//
 
 Ship::Ship(int imageID, double startX, double startY, StudentWorld* world, double hitPts, int dir = 0, double size = 1.0, int depth = 0)
@@ -99,19 +118,34 @@ Ship::Ship(int imageID, double startX, double startY, StudentWorld* world, doubl
 
 double Ship::getHitPts() const {return m_hitPts;}
 void Ship::increaseHitPts(double amt) { //increases NachenBlaster's hit points
-    if (m_hitPts + amt <= 50)
+    if (m_hitPts + amt <= PLAYER_MAX_HIT_POINTS)
         m_hitPts += amt;
     else
-        m_hitPts = 50; //if amt exceeds 50, set NachenBlaster's health to its max health (50 hit points)
+        m_hitPts = PLAYER_MAX_HIT_POINTS; //if amt overshoots, set NachenBlaster's health to its max health
 }
 void Ship::decHitPts(double amt) {m_hitPts -= amt;}
 
+void Ship::saveState(ActorState& s) const
+{
+    Actor::saveState(s);
+    s.hitPts = m_hitPts;
+}
+
+void Ship::loadState(const ActorState& s)
+{
+    Actor::loadState(s);
+    m_hitPts = s.hitPts;
+}
+
 
 //****** PLAYER ******//
 
 NachenBlaster::NachenBlaster(StudentWorld* world)
-: Ship(IID_NACHENBLASTER, 0, 128, world, 50), m_cabbage(30), m_torpedo(0)
-{setTag(PLAYER);}
+: Ship(IID_NACHENBLASTER, 0, 128, world, PLAYER_MAX_HIT_POINTS), m_cabbage(PLAYER_MAX_CABBAGES), m_torpedo(0)
+{
+    setTag(PLAYER);
+    setCollisionLayer(LAYER_PLAYER);
+}
 
 void NachenBlaster::doSomething()
 {
@@ -119,7 +153,7 @@ void NachenBlaster::doSomething()
     int ch;
     double x = getX();
     double y = getY();
-    if (getWorld()->getKey(ch)) // user hit a key during this tick!
+    if (getWorld()->getPlayerKey(ch)) // user hit a key during this tick!
     {
         switch (ch)
         {
@@ -143,7 +177,7 @@ void NachenBlaster::doSomething()
                 break;
         }
     }
-    if (m_cabbage < 30)
+    if (m_cabbage < PLAYER_MAX_CABBAGES)
         m_cabbage++;
 }
 
@@ -153,48 +187,49 @@ void NachenBlaster::fire(int tag)
     {
         getWorld()->addProjectile(getX()+12, getY(), PLAYER_TORPEDO);
         m_torpedo--;
-        getWorld()->playSound(SOUND_TORPEDO);
+        getWorld()->queueSound(SOUND_TORPEDO);
         return;
     }
     else if (tag == IID_CABBAGE && m_cabbage >= 5) //fire cabbage
     {
         getWorld()->addProjectile(getX()+12, getY(), IID_CABBAGE);
         m_cabbage -= 5;
-        getWorld()->playSound(SOUND_PLAYER_SHOOT);
+        getWorld()->queueSound(SOUND_PLAYER_SHOOT);
     }
 }
 
-bool NachenBlaster::isCollidable(int enemy) const //player can only collide with an Alien or Alien projectile
-{
-    if (isAlien(enemy) || enemy == IID_TURNIP || enemy == ALIEN_TORPEDO)
-        return true;
-    return false;
-}
-
 void NachenBlaster::sufferDamage(int enemy)
 {
-    //player takes damage according to identity of the enemy
-    if (enemy == IID_TURNIP)
-        decHitPts(2);
-    else if (enemy == IID_SNAGGLEGON)
-        decHitPts(15);
-    else if (isAlien(enemy))
-        decHitPts(5);
-    else if (enemy == ALIEN_TORPEDO)
-        decHitPts(8);
-    if (getHitPts() <= 0) //player loses a life
+    //player takes damage according to identity of the enemy (GameRules.h)
+    const Damage& d = damageFrom(enemy, VICTIM_PLAYER);
+    decHitPts(d.damage);
+    if (getHitPts() <= 0 || d.lethal) //player loses a life
     {
         die();
         getWorld()->decLives();
     }
-    else if (!isAlien(enemy)) //player hit by enemy projectile
-        getWorld()->playSound(SOUND_BLAST);
+    else if (d.sound != SOUND_NONE) //player hit by enemy projectile
+        getWorld()->queueSound(d.sound);
 }
 
 void NachenBlaster::incTorpedo(int torpedo) { m_torpedo += torpedo;}
 int NachenBlaster::getCabbages() const {return m_cabbage;}
 int NachenBlaster::getTorpedoes() const {return m_torpedo;}
 
+void NachenBlaster::saveState(ActorState& s) const
+{
+    Ship::saveState(s);
+    s.cabbages = m_cabbage;
+    s.torpedoes = m_torpedo;
+}
+
+void NachenBlaster::loadState(const ActorState& s)
+{
+    Ship::loadState(s);
+    m_cabbage = s.cabbages;
+    m_torpedo = s.torpedoes;
+}
+
 
 //****** PROJECTILES ******//
 
@@ -213,7 +248,7 @@ void Projectile::actProj(int move, bool spin)
         return;
     }
     
-    if (getWorld()->processCollision(this)) { //check collision: triggers its target's sufferDamage function
+    if (getWorld()->processCollision(this)) { //check collision: queues damage for its target
         die();
         return;
     }
@@ -227,7 +262,11 @@ void Projectile::actProj(int move, bool spin)
 
 Cabbage::Cabbage(double startX, double startY, StudentWorld* world)
 : Projectile(IID_CABBAGE, startX, startY, world)
-{setTag(IID_CABBAGE);}
+{
+    setTag(IID_CABBAGE);
+    setArchetype(ARCH_CABBAGE);
+    setCollisionLayer(LAYER_PLAYER_SHOT);
+}
 
 void Cabbage::doSomething()
 {
@@ -236,7 +275,11 @@ void Cabbage::doSomething()
 
 Turnip::Turnip(double startX, double startY, StudentWorld* world)
 : Projectile(IID_TURNIP, startX, startY, world)
-{setTag(IID_TURNIP);}
+{
+    setTag(IID_TURNIP);
+    setArchetype(ARCH_TURNIP);
+    setCollisionLayer(LAYER_ALIEN_SHOT);
+}
 
 void Turnip::doSomething()
 {
@@ -245,7 +288,11 @@ void Turnip::doSomething()
 
 Torpedo::Torpedo(double startX, double startY, StudentWorld* world, int tag)
 : Projectile(IID_TORPEDO, startX, startY, world, (tag == PLAYER_TORPEDO) ? 0 : 180)
-{setTag(tag);}
+{
+    setTag(tag);
+    setArchetype(ARCH_TORPEDO);
+    setCollisionLayer((tag == PLAYER_TORPEDO) ? LAYER_PLAYER_SHOT : LAYER_ALIEN_SHOT);
+}
 
 void Torpedo::doSomething()
 {
@@ -258,151 +305,126 @@ void Torpedo::doSomething()
 
 //****** ALIENS ******//
 
-Alien::Alien(int imageID, double startX, double startY, int levelNum, StudentWorld* world, int hits = 5, double speed = 2.0, int travelDir = DOWN_LEFT, int dir = 0, double size = 1.5, int depth = 1)
-: Ship(imageID, startX, startY, world, hits * (1 + (levelNum - 1) * .1), dir, size, depth), m_flight(0), m_speed(speed), m_travelDir(travelDir)
-{}
-
-bool Alien::isCollidable(int enemy) const //alien can only collide with player or player's projectiles
+//Each kind of alien's image, hit points and speed come from its row in ALIEN_KINDS (GameRules.h)
+Alien::Alien(int archetype, double startX, double startY, int levelNum, StudentWorld* world)
+: Ship(alienKind(archetype).imageID, startX, startY, world, alienHitPoints(archetype, levelNum), 0, 1.5, 1), m_flight(0), m_speed(alienKind(archetype).speed), m_travelDir(DOWN_LEFT)
 {
-    if (enemy == PLAYER || enemy == IID_CABBAGE || enemy == PLAYER_TORPEDO)
-        return true;
-    return false;
+    setTag(alienKind(archetype).imageID);
+    setArchetype(archetype);
+    setCollisionLayer(LAYER_ALIEN);
 }
 
+int Alien::getFlight() const {return m_flight;}
+int Alien::getTravelDir() const {return m_travelDir;}
+double Alien::getSpeed() const {return m_speed;}
+
 void Alien::sufferDamage(int enemy)
 {
-    //alien takes damage according to identity of its enemy
-    if (enemy == IID_CABBAGE)
-        decHitPts(2);
-    else if (enemy == PLAYER_TORPEDO)
-        decHitPts(8);
+    //alien takes damage according to identity of its enemy (GameRules.h)
+    const Damage& d = damageFrom(enemy, VICTIM_ALIEN);
+    decHitPts(d.damage);
     
-    if (getHitPts() <= 0 || enemy == PLAYER) //alien is dead!
+    if (getHitPts() <= 0 || d.lethal) //alien is dead!
     {
-        if (enemy == IID_SNAGGLEGON)
-            getWorld()->increaseScore(1000);
-        else
-            getWorld()->increaseScore(250);
+        const AlienKind& kind = alienKind(getArchetype());
+        getWorld()->queueScore(kind.score);
         die();
         getWorld()->incDestroyedAliens();
-        getWorld()->playSound(SOUND_DEATH);
+        getWorld()->queueSound(SOUND_DEATH);
         getWorld()->addExplosion(getX(), getY());
         
         //Smoregons and Snagglegons might drop goodies
-        if (getTag() == IID_SMOREGON)
-            getWorld()->addGoodieMaybe(getX(), getY(), GAMEOBJECT);
-        if (getTag() == IID_SNAGGLEGON)
-            getWorld()->addGoodieMaybe(getX(), getY(), IID_LIFE_GOODIE);
+        if (kind.drop != NO_DROP)
+            getWorld()->addGoodieMaybe(getX(), getY(), kind.drop);
     }
-    else
-        getWorld()->playSound(SOUND_BLAST);
+    else if (d.sound != SOUND_NONE)
+        getWorld()->queueSound(d.sound);
 }
 
 void Alien::fire(int tag)
 {
     if (tag == ALIEN_TORPEDO) { //fire torpedo and play its sound
-        getWorld()->playSound(SOUND_TORPEDO);
+        getWorld()->queueSound(SOUND_TORPEDO);
         getWorld()->addProjectile(getX()-14, getY(), ALIEN_TORPEDO);
         return;
     }
     //else: fire a turnip
-    getWorld()->playSound(SOUND_ALIEN_SHOOT);
+    getWorld()->queueSound(SOUND_ALIEN_SHOOT);
     getWorld()->addProjectile(getX()-14, getY(), IID_TURNIP);
 }
 
-void Alien::act(int tag) 
+void Alien::act()
 {
     if (!isAlive()) return;
-    double x = getX();
-    double y = getY();
     
-    if (x < 0) {
+    if (getX() < 0) {
         die();
         return;
     }
     
-    if (getWorld()->processCollision(this)) { //checks collision with player: triggers player's sufferDamage function
+    if (getWorld()->processCollision(this)) { //checks collision with player: queues damage for the player
         sufferDamage(PLAYER); //then calls Alien's own sufferDamage function
         return;
     }
     
-    if (m_flight == 0 || y >= VIEW_HEIGHT-1 || y <= 0) //if flight path reaches 0 or reaches bottom/top of screen
-    {
-        if (y >= VIEW_HEIGHT-1)
-            m_travelDir = DOWN_LEFT;
-        else if (y <= 0)
-            m_travelDir = UP_LEFT;
-        else if (m_flight == 0 && tag != IID_SNAGGLEGON)
-            m_travelDir = randInt(0, 2); //random travel direction: down and left, up and left, or due left
-        if (tag != IID_SNAGGLEGON) m_flight = randInt(1, 32);
-    }
-    
-    //Potentially fire a projectile
-    NachenBlaster* nb = getWorld()->getNB();
-    const int rand = randInt(0, ((20/getWorld()->getLevel()+5)-1));
-    const int randSmor = randInt(0, ((20/getWorld()->getLevel()+5)-1));
-    const int randSnag = randInt(0, ((15/getWorld()->getLevel()+10)-1));
-    if (nb->getX() < x && nb->getY() >= y-4 && nb->getY() <= y+4)
-    {
-        if (tag == IID_SNAGGLEGON && randSnag < 1) { //Snagglegon fires torpedo
-            fire(ALIEN_TORPEDO);
-            return;
-        }
-        else if (tag != IID_SNAGGLEGON && rand < 1) { //other aliens fire turnips
-            fire(IID_TURNIP);
-            return;
-        }
-        if (tag == IID_SMOREGON && randSmor < 1) //Smoregon randomly charges
-        {
-            m_travelDir = DUE_LEFT;
-            m_flight = VIEW_WIDTH;
-            m_speed = 5;
-        }
-    }
-    
-    switch (m_travelDir) { //move according to travelDir
-        case UP_LEFT:
-            moveTo(x - m_speed, y + m_speed);
-            break;
-        case DOWN_LEFT:
-            moveTo(x - m_speed, y - m_speed);
-            break;
-        case DUE_LEFT:
-            moveTo(x - m_speed, y);
-            break;
+    //follow the plan this alien's flight kernel made earlier this tick (AlienKernels.h)
+    const ActorStore::Group& g = getWorld()->getActors().group(getArchetype());
+    const int k = getSlot();
+    m_travelDir = g.travelDir[k];
+    m_flight = g.flight[k];
+    m_speed = fromFixed(g.speed[k]);
+    if (g.fireTag[k] != GAMEOBJECT) {
+        fire(g.fireTag[k]);
+        return;
     }
-    m_flight--;
+    moveTo(fromFixed(g.destX[k]), fromFixed(g.destY[k]));
     
     if (getWorld()->processCollision(this)) { //checks collision again
         sufferDamage(PLAYER);
     }
 }
 
+void Alien::saveState(ActorState& s) const //the plan is made fresh every tick, so it isn't saved
+{
+    Ship::saveState(s);
+    s.flight = m_flight;
+    s.travelDir = m_travelDir;
+    s.speed = m_speed;
+}
+
+void Alien::loadState(const ActorState& s)
+{
+    Ship::loadState(s);
+    m_flight = s.flight;
+    m_travelDir = s.travelDir;
+    m_speed = s.speed;
+}
+
 Smallgon::Smallgon(double startX, double startY, int levelNum, StudentWorld* world)
-: Alien(IID_SMALLGON, startX, startY, levelNum, world)
-{setTag(IID_SMALLGON);}
+: Alien(ARCH_SMALLGON, startX, startY, levelNum, world)
+{}
 
 void Smallgon::doSomething()
 {
-    act(IID_SMALLGON);
+    act();
 }
 
 Smoregon::Smoregon(double startX, double startY, int levelNum, StudentWorld* world)
-: Alien(IID_SMOREGON, startX, startY, levelNum, world)
-{setTag(IID_SMOREGON);}
+: Alien(ARCH_SMOREGON, startX, startY, levelNum, world)
+{}
 
 void Smoregon::doSomething()
 {
-    act(IID_SMOREGON);
+    act();
 }
 
 Snagglegon::Snagglegon(double startX, double startY, int levelNum, StudentWorld* world)
-: Alien(IID_SNAGGLEGON, startX, startY, levelNum, world, 10, 1.75)
-{setTag(IID_SNAGGLEGON);}
+: Alien(ARCH_SNAGGLEGON, startX, startY, levelNum, world)
+{}
 
 void Snagglegon::doSomething()
 {
-    act(IID_SNAGGLEGON);
+    act();
 }
 
 
@@ -411,7 +433,7 @@ Goodie::Goodie(int imageID, double startX, double startY, StudentWorld* world, i
 : Actor(imageID, startX, startY, world, dir, size, depth)
 {}
 
-void Goodie::act(int tag)
+void Goodie::act()
 {
     if (!isAlive()) return;
     double x = getX();
@@ -422,61 +444,52 @@ void Goodie::act(int tag)
         return;
     }
 
-    if (getWorld()->getNB()->collision(this)) //check collision with player
+    Actor* nb = getWorld()->getActor(getWorld()->getPlayer());
+    if (nb != nullptr && nb->collision(this)) //check collision with player
     {
-        activateMe(tag); //activates this goodie's benefits
+        activateMe(); //activates this goodie's benefits
         return;
     }
 
     moveTo(x-.75, y-.75);
 
-    if (getWorld()->getNB()->collision(this))
-        activateMe(tag);
+    if (nb != nullptr && nb->collision(this))
+        activateMe();
 }
 
-void Goodie::activateMe(int good)
+void Goodie::activateMe()
 {
     StudentWorld* w = getWorld();
-    w->increaseScore(100);
+    w->queueScore(goodieKind(getArchetype()).score);
     die();
-    w->playSound(SOUND_GOODIE);
-    switch (good) { //gives different benefits to player depending on identity of goodie
-        case IID_REPAIR_GOODIE:
-            w->getNB()->increaseHitPts(10);
-            break;
-        case IID_LIFE_GOODIE:
-            w->incLives();
-            break;
-        case IID_TORPEDO_GOODIE:
-            w->getNB()->incTorpedo(5);
-            break;
-    }
+    w->queueSound(SOUND_GOODIE);
+    w->queueGoodie(getArchetype()); //gives different benefits to player depending on kind of goodie
 }
 
 Repair::Repair(double startX, double startY, StudentWorld* world)
 : Goodie(IID_REPAIR_GOODIE, startX, startY, world)
-{}
+{setArchetype(ARCH_REPAIR);}
 
 void Repair::doSomething()
 {
-    act(IID_REPAIR_GOODIE);
+    act();
 }
 
 ExtraLife::ExtraLife(double startX, double startY, StudentWorld* world)
 : Goodie(IID_LIFE_GOODIE, startX, startY, world)
-{}
+{setArchetype(ARCH_EXTRA_LIFE);}
 
 void ExtraLife::doSomething()
 {
-    act(IID_LIFE_GOODIE);
+    act();
 }
 
 TorpedoGoodie::TorpedoGoodie(double startX, double startY, StudentWorld* world)
 : Goodie(IID_TORPEDO_GOODIE, startX, startY, world)
-{}
+{setArchetype(ARCH_TORPEDO_GOODIE);}
 
 void TorpedoGoodie::doSomething()
 {
-    act(IID_TORPEDO_GOODIE);
+    act();
 }
 
@@ -2,6 +2,8 @@
 #define ACTOR_H_
 
 #include "GraphObject.h"
+#include "CollisionLayers.h"
+#include "ActorHandle.h"
 
 //TravelDir
 const int NO_TRAVEL = -1;
@@ -16,46 +18,51 @@ const int ALIEN_TORPEDO = 13;
 const int PLAYER = 14;
 
 class StudentWorld;
+struct ActorState;
 
 class Actor:    public GraphObject
 {
 public:
-    Actor(int imageID, double startX, double startY, int dir, double size, int depth);
     Actor(int imageID, double startX, double startY, StudentWorld* world, int dir, double size, int depth);
     virtual void doSomething() = 0;
+    virtual void moveTo(double x, double y);
+    void setSize(double size);
     void die();
     bool isAlive() const;
     bool inBounds(double x, double y) const;
     StudentWorld* getWorld() const;
     bool collision(Actor* a2) const;
-    virtual void act(int tag);
     virtual void sufferDamage(int enemy);
-    virtual bool isCollidable(int enemy) const;
+    virtual void saveState(ActorState& s) const; //for rewinding (see WorldSnapshot.h)
+    virtual void loadState(const ActorState& s);
+    bool canBeHitBy(const Actor* a2) const;
+    unsigned int getCollisionLayer() const;
+    unsigned int getHitMask() const;
+    void setCollisionLayer(unsigned int layer);
     int getTag() const;
     void setTag(int tag);
     bool isAlien(int tag) const;
+    int getBroadphaseSlot() const;
+    void setBroadphaseSlot(int slot);
+    int getArchetype() const;
+    void setArchetype(int archetype);
+    int getSlot() const;
+    void setSlot(int slot);
+    unsigned long getSpawnSeq() const;
+    void setSpawnSeq(unsigned long seq);
+    ActorHandle getHandle() const;
+    void setHandle(ActorHandle handle);
 private:
     bool alive;
     StudentWorld* m_world;
     int m_tag; //identifies each actor
-};
-
-//****** Star ******//
-class Star:    public Actor
-{
-public:
-    Star(double startX, double startY);
-    virtual void doSomething();
-};
-
-//****** Explosion ******//
-class Explosion:    public Actor
-{
-public:
-    Explosion(double startX, double startY);
-    virtual void doSomething();
-private:
-    int countdown;
+    unsigned int m_layer;
+    unsigned int m_hitMask; //layers that can hit this actor
+    int m_broadphaseSlot; //where the world's broadphase filed this actor (grid cell or sweep index), or -1
+    int m_archetype; //group in the world's ActorStore (see ActorStore.h)
+    int m_slot; //index within that group, or -1 if not stored there
+    unsigned long m_spawnSeq; //when the world added this actor: earlier actors win collision ties
+    ActorHandle m_handle; //how the world refers to this actor (see ActorHandle.h), or NO_ACTOR
 };
 
 //****** Damageable Object Abstract Class ******//
@@ -67,22 +74,25 @@ public:
     void increaseHitPts(double amt);
     void decHitPts(double amt);
     virtual void fire(int tag) = 0;
+    virtual void saveState(ActorState& s) const;
+    virtual void loadState(const ActorState& s);
 private:
     double m_hitPts;
 };
 
 //****** NachenBlaster ******//
-class NachenBlaster:    public Ship
+class NachenBlaster final:    public Ship
 {
 public:
     NachenBlaster(StudentWorld* world);
     virtual void doSomething();
     virtual void sufferDamage(int enemy);
-    virtual bool isCollidable(int enemy) const;
     virtual void fire(int tag);
     void incTorpedo(int torpedo);
     int getCabbages() const;
     int getTorpedoes() const;
+    virtual void saveState(ActorState& s) const;
+    virtual void loadState(const ActorState& s);
 private:
     int m_cabbage;
     int m_torpedo;
@@ -96,21 +106,21 @@ public:
     void actProj(int move, bool spin);
 };
 
-class Cabbage:    public Projectile
+class Cabbage final:    public Projectile
 {
 public:
     Cabbage(double startX, double startY, StudentWorld* world);
     virtual void doSomething();
 };
 
-class Turnip:   public Projectile
+class Turnip final:   public Projectile
 {
 public:
     Turnip(double startX, double startY, StudentWorld* world);
     virtual void doSomething();
 };
 
-class Torpedo:  public Projectile
+class Torpedo final:  public Projectile
 {
 public:
     Torpedo(double startX, double startY, StudentWorld* world, int tag);
@@ -121,32 +131,36 @@ public:
 class Alien:    public Ship
 {
 public:
-    Alien(int imageID, double startX, double startY, int levelNum, StudentWorld* world, int hits, double speed, int travelDir, int dir, double size, int depth);
-    virtual bool isCollidable(int enemy) const;
+    Alien(int archetype, double startX, double startY, int levelNum, StudentWorld* world);
     virtual void sufferDamage(int enemy);
     virtual void fire(int tag);
-    virtual void act(int tag);
+    void act(); //what every kind of alien does each tick
+    virtual void saveState(ActorState& s) const;
+    virtual void loadState(const ActorState& s);
+    int getFlight() const;
+    int getTravelDir() const;
+    double getSpeed() const;
 private:
     int m_flight; //flight plan length
     double m_speed;
     int m_travelDir;
 };
 
-class Smallgon:    public Alien
+class Smallgon final:    public Alien
 {
 public:
     Smallgon(double startX, double startY, int levelNum, StudentWorld* world);
     virtual void doSomething();
 };
 
-class Smoregon:    public Alien
+class Smoregon final:    public Alien
 {
 public:
     Smoregon(double startX, double startY, int levelNum, StudentWorld* world);
     virtual void doSomething();
 };
 
-class Snagglegon:   public Alien
+class Snagglegon final:   public Alien
 {
 public:
     Snagglegon(double startX, double startY, int levelNum, StudentWorld* world);
@@ -158,25 +172,25 @@ class Goodie:   public Actor
 {
 public:
     Goodie(int imageID, double startX, double startY, StudentWorld* world, int dir, double size, int depth);
-    virtual void act(int tag);
-    void activateMe(int good);
+    void act(); //what every kind of goodie does each tick
+    void activateMe();
 };
 
-class Repair:   public Goodie
+class Repair final:   public Goodie
 {
 public:
     Repair(double startX, double startY, StudentWorld* world);
     virtual void doSomething();
 };
 
-class ExtraLife:    public Goodie
+class ExtraLife final:    public Goodie
 {
 public:
     ExtraLife(double startX, double startY, StudentWorld* world);
     virtual void doSomething();
 };
 
-class TorpedoGoodie:    public Goodie
+class TorpedoGoodie final:    public Goodie
 {
 public:
     TorpedoGoodie(double startX, double startY, StudentWorld* world);
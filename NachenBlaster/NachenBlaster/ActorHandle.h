@@ -0,0 +1,98 @@
+#ifndef ACTORHANDLE_H_
+#define ACTORHANDLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Actor;
+
+//A reference to an actor that is safe to hold after the actor is gone: an
+//index into the world's ActorHandles table plus the generation of that entry
+//when the handle was issued.  Releasing an entry bumps its generation, so a
+//stale handle looks up as nullptr instead of reaching a dead actor.
+struct ActorHandle
+{
+    uint32_t index;
+    uint32_t generation; //never 0 for an issued handle
+
+    bool operator==(const ActorHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const ActorHandle& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+const ActorHandle NO_ACTOR = {0, 0}; //refers to nothing, ever
+
+//Table of the live actors' handles.  Entries of released handles are kept on
+//a free list and reused with the next generation, so the table stays as long
+//as the most actors alive at once, and add, remove and get are all O(1).
+class ActorHandles
+{
+public:
+    ActorHandles()
+    : m_free(NONE), m_live(0)
+    {}
+
+    ActorHandle add(Actor* a)
+    {
+        uint32_t k;
+        if (m_free != NONE)
+        {
+            k = m_free;
+            m_free = m_entries[k].nextFree;
+        }
+        else
+        {
+            k = (uint32_t)m_entries.size();
+            m_entries.push_back(Entry{nullptr, 1, NONE});
+        }
+        m_entries[k].actor = a;
+        m_live++;
+        return ActorHandle{k, m_entries[k].generation};
+    }
+
+    void remove(ActorHandle h) //does nothing if h is already stale
+    {
+        if (get(h) == nullptr)
+            return;
+        Entry& e = m_entries[h.index];
+        e.actor = nullptr;
+        e.generation = (e.generation == UINT32_MAX) ? 1 : e.generation + 1;
+        e.nextFree = m_free;
+        m_free = h.index;
+        m_live--;
+    }
+
+    Actor* get(ActorHandle h) const //nullptr if h's actor is gone
+    {
+        if (h.index >= m_entries.size() || m_entries[h.index].generation != h.generation)
+            return nullptr;
+        return m_entries[h.index].actor;
+    }
+
+    size_t size() const //live handles
+    {
+        return m_live;
+    }
+
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Entry
+    {
+        Actor* actor; //nullptr while on the free list
+        uint32_t generation;
+        uint32_t nextFree;
+    };
+    std::vector<Entry> m_entries;
+    uint32_t m_free; //first entry on the free list
+    size_t m_live;
+};
+
+#endif // ACTORHANDLE_H_
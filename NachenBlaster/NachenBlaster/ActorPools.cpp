@@ -0,0 +1,27 @@
+#include "ActorPools.h"
+#include "ActorStore.h"
+using namespace std;
+
+//Starting sizes comfortably cover a normal level; stress runs grow the pools a few times, early on
+ActorPools::ActorPools()
+: m_pools(32, 32, 32,   //Smallgons, Smoregons, Snagglegons
+          64, 128, 64,  //cabbages, turnips, torpedoes
+          16, 16, 16)   //goodies
+{}
+
+void ActorPools::destroy(Actor* a)
+{
+    switch (a->getArchetype())
+    {
+        case ARCH_SMALLGON:       destroyAs<Smallgon>(a);      break;
+        case ARCH_SMOREGON:       destroyAs<Smoregon>(a);      break;
+        case ARCH_SNAGGLEGON:     destroyAs<Snagglegon>(a);    break;
+        case ARCH_CABBAGE:        destroyAs<Cabbage>(a);       break;
+        case ARCH_TURNIP:         destroyAs<Turnip>(a);        break;
+        case ARCH_TORPEDO:        destroyAs<Torpedo>(a);       break;
+        case ARCH_REPAIR:         destroyAs<Repair>(a);        break;
+        case ARCH_EXTRA_LIFE:     destroyAs<ExtraLife>(a);     break;
+        case ARCH_TORPEDO_GOODIE: destroyAs<TorpedoGoodie>(a); break;
+        default:                  delete a;                    break;
+    }
+}
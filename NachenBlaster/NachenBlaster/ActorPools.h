@@ -0,0 +1,43 @@
+#ifndef ACTORPOOLS_H_
+#define ACTORPOOLS_H_
+
+#include "ActorStore.h"
+#include "ObjectPool.h"
+#include <tuple>
+#include <utility>
+
+//One ObjectPool per kind of spawned actor, owned by a StudentWorld and reused
+//across ticks and levels, so spawning and removing actors doesn't touch the heap.
+class ActorPools
+{
+public:
+    ActorPools();
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return std::get<ObjectPool<T>>(m_pools).create(std::forward<Args>(args)...);
+    }
+
+    void destroy(Actor* a); //returns a to the pool for its archetype
+
+private:
+    template<typename Types>
+    struct PoolsFor;
+
+    template<typename... T>
+    struct PoolsFor<std::tuple<T...>>
+    {
+        typedef std::tuple<ObjectPool<T>...> type;
+    };
+
+    typename PoolsFor<ArchetypeTypes>::type m_pools; //one pool per archetype, in archetype order
+
+    template<typename T>
+    void destroyAs(Actor* a)
+    {
+        std::get<ObjectPool<T>>(m_pools).destroy(static_cast<T*>(a));
+    }
+};
+
+#endif // ACTORPOOLS_H_
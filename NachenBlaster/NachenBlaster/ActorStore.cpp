@@ -0,0 +1,68 @@
+#include "ActorStore.h"
+using namespace std;
+
+void ActorStore::add(Actor* a)
+{
+    Group& g = m_groups[a->getArchetype()];
+    a->setSlot((int)g.size());
+    g.actor.push_back(a);
+    g.alive.push_back(a->isAlive());
+    const Alien* al = isAlienArchetype(a->getArchetype()) ? static_cast<const Alien*>(a) : nullptr;
+    g.x.push_back(al != nullptr ? a->getFixedX() : 0);
+    g.y.push_back(al != nullptr ? a->getFixedY() : 0);
+    g.travelDir.push_back(al != nullptr ? al->getTravelDir() : 0);
+    g.flight.push_back(al != nullptr ? al->getFlight() : 0);
+    g.speed.push_back(al != nullptr ? toFixed(al->getSpeed()) : 0);
+    g.fireTag.push_back(GAMEOBJECT);
+    g.destX.push_back(g.x.back());
+    g.destY.push_back(g.y.back());
+}
+
+void ActorStore::sync(const Actor* a)
+{
+    Group& g = m_groups[a->getArchetype()];
+    const int k = a->getSlot();
+    g.alive[k] = a->isAlive();
+    if (isAlienArchetype(a->getArchetype())) //nothing sweeps the others' positions
+    {
+        g.x[k] = a->getFixedX();
+        g.y[k] = a->getFixedY();
+    }
+}
+
+size_t ActorStore::size() const
+{
+    size_t n = 0;
+    for (const Group& g : m_groups)
+        n += g.size();
+    return n;
+}
+
+void ActorStore::moveSlot(Group& g, size_t from, size_t to)
+{
+    g.actor[to] = g.actor[from];
+    g.x[to] = g.x[from];
+    g.y[to] = g.y[from];
+    g.alive[to] = g.alive[from];
+    g.travelDir[to] = g.travelDir[from];
+    g.flight[to] = g.flight[from];
+    g.speed[to] = g.speed[from];
+    g.fireTag[to] = g.fireTag[from];
+    g.destX[to] = g.destX[from];
+    g.destY[to] = g.destY[from];
+    g.actor[to]->setSlot((int)to);
+}
+
+void ActorStore::resize(Group& g, size_t n)
+{
+    g.actor.resize(n);
+    g.x.resize(n);
+    g.y.resize(n);
+    g.alive.resize(n);
+    g.travelDir.resize(n);
+    g.flight.resize(n);
+    g.speed.resize(n);
+    g.fireTag.resize(n);
+    g.destX.resize(n);
+    g.destY.resize(n);
+}
@@ -0,0 +1,127 @@
+#ifndef ACTORSTORE_H_
+#define ACTORSTORE_H_
+
+#include "Actor.h"
+#include <tuple>
+#include <vector>
+
+//Archetypes: every concrete kind of actor is stored in its own group, and
+//groups are updated in this order each tick
+const int ARCH_NONE           = -1; //not kept in an ActorStore (the player)
+const int ARCH_SMALLGON       = 0;
+const int ARCH_SMOREGON       = 1;
+const int ARCH_SNAGGLEGON     = 2;
+const int ARCH_CABBAGE        = 3;
+const int ARCH_TURNIP         = 4;
+const int ARCH_TORPEDO        = 5;
+const int ARCH_REPAIR         = 6;
+const int ARCH_EXTRA_LIFE     = 7;
+const int ARCH_TORPEDO_GOODIE = 8;
+const int NUM_ARCHETYPES      = 9;
+
+//The concrete actor type of each archetype, in archetype order.  Everything
+//kept in an ActorStore is one of these, so code that loops over a group can
+//use its exact type and call it directly instead of through the vtable.
+typedef std::tuple<Smallgon, Smoregon, Snagglegon,
+                   Cabbage, Turnip, Torpedo,
+                   Repair, ExtraLife, TorpedoGoodie> ArchetypeTypes;
+
+template<int archetype>
+using ArchetypeType = std::tuple_element_t<archetype, ArchetypeTypes>;
+
+static_assert(std::tuple_size<ArchetypeTypes>::value == NUM_ARCHETYPES, "one type per archetype");
+
+inline bool isAlienArchetype(int archetype)
+{
+    return archetype >= ARCH_SMALLGON && archetype <= ARCH_SNAGGLEGON;
+}
+
+//Actor storage grouped by archetype.  Each group keeps, in parallel arrays,
+//the fields that sweeps over a whole group read: the alive flag, for removing
+//the dead, and for aliens the position and flight the flight kernels plan
+//from.  They are mirrored from the actors as they change, so those sweeps walk
+//contiguous memory instead of chasing pointers into every object.
+//Actors keep their slot index; removal compacts a group in place, keeping
+//spawn order.
+class ActorStore
+{
+public:
+    struct Group
+    {
+        std::vector<Actor*> actor;
+        std::vector<unsigned char> alive;
+        //Aliens only; other groups leave these at zero.  Where each alien is
+        //and the flight it is on, which the flight kernels (AlienKernels.h)
+        //advance every tick before the aliens act, and what they decided the
+        //alien does this tick
+        std::vector<Fixed> x; //16.16, as the actors keep them
+        std::vector<Fixed> y;
+        std::vector<int> travelDir;
+        std::vector<int> flight;
+        std::vector<Fixed> speed;
+        std::vector<int> fireTag; //projectile to fire instead of moving, or GAMEOBJECT
+        std::vector<Fixed> destX; //where to move to, if not firing
+        std::vector<Fixed> destY;
+
+        size_t size() const
+        {
+            return actor.size();
+        }
+    };
+
+    void add(Actor* a);
+    void sync(const Actor* a); //refresh a's mirrored fields after it changes
+    size_t size() const;
+
+    Group& group(int archetype)
+    {
+        return m_groups[archetype];
+    }
+
+    const Group& group(int archetype) const
+    {
+        return m_groups[archetype];
+    }
+
+    //Drops every dead actor, calling onRemove(actor) on each one as it goes
+    template<typename Func>
+    void removeDead(Func onRemove)
+    {
+        for (Group& g : m_groups)
+        {
+            size_t kept = 0;
+            for (size_t k = 0; k < g.size(); k++)
+            {
+                if (!g.alive[k])
+                {
+                    onRemove(g.actor[k]);
+                    continue;
+                }
+                if (kept != k)
+                    moveSlot(g, k, kept);
+                kept++;
+            }
+            resize(g, kept);
+        }
+    }
+
+    //Drops every actor, calling onRemove(actor) on each one
+    template<typename Func>
+    void clear(Func onRemove)
+    {
+        for (Group& g : m_groups)
+        {
+            for (Actor* a : g.actor)
+                onRemove(a);
+            resize(g, 0); //keeps capacity for the next level
+        }
+    }
+
+private:
+    Group m_groups[NUM_ARCHETYPES];
+
+    static void moveSlot(Group& g, size_t from, size_t to);
+    static void resize(Group& g, size_t n);
+};
+
+#endif // ACTORSTORE_H_
@@ -0,0 +1,137 @@
+#include "AlienKernels.h"
+#include "GameConstants.h"
+#include "RandomGenerator.h"
+using namespace std;
+
+TickInfo makeTickInfo(Fixed playerX, Fixed playerY, int level, int fireOdds, unsigned long long key)
+{
+    TickInfo tick;
+    tick.playerX = playerX;
+    tick.playerY = playerY;
+    tick.turnipOdds = 20/level + 5;
+    tick.torpedoOdds = 15/level + 10;
+    tick.chargeOdds = 20/level + 5;
+    tick.fireOdds = fireOdds;
+    tick.key = key;
+    return tick;
+}
+
+//What sets each kind of alien's flight apart
+struct SmallgonFlight
+{
+    static const bool RANDOM_FLIGHTS = true; //picks a new direction and length when its flight runs out
+    static const bool CHARGES = false;
+    static const int SHOT = IID_TURNIP;
+};
+
+struct SmoregonFlight
+{
+    static const bool RANDOM_FLIGHTS = true;
+    static const bool CHARGES = true; //may dash at the player instead of firing
+    static const int SHOT = IID_TURNIP;
+};
+
+struct SnagglegonFlight
+{
+    static const bool RANDOM_FLIGHTS = false; //only bounces off the top and bottom
+    static const bool CHARGES = false;
+    static const int SHOT = ALIEN_TORPEDO;
+};
+
+template<typename Kind>
+static void planBlock(ActorStore::Group& g, size_t begin, size_t end, const TickInfo& tick, RandomGenerator& rng)
+{
+    //every alien gets its draws whether it needs them or not
+    const int n = (int)(end - begin);
+    int dirs[ALIEN_BLOCK];
+    int flights[ALIEN_BLOCK];
+    int shots[ALIEN_BLOCK];
+    int charges[ALIEN_BLOCK];
+    const bool aimed = (tick.fireOdds == 0); //stress runs fire at a fixed rate, aimed or not
+    const int shotOdds = !aimed ? tick.fireOdds : (Kind::SHOT == ALIEN_TORPEDO) ? tick.torpedoOdds : tick.turnipOdds;
+    if (Kind::RANDOM_FLIGHTS)
+    {
+        rng.randInts(dirs, n, 0, 2); //down and left, up and left, or due left
+        rng.randInts(flights, n, 1, 32);
+    }
+    rng.randInts(shots, n, 0, shotOdds-1);
+    if (Kind::CHARGES && aimed)
+        rng.randInts(charges, n, 0, tick.chargeOdds-1);
+    
+    const Fixed top = (VIEW_HEIGHT-1) * FIXED_ONE;
+    const Fixed lineOfFire = 4 * FIXED_ONE;
+    for (int j = 0; j < n; j++)
+    {
+        const size_t k = begin + j;
+        const Fixed x = g.x[k];
+        const Fixed y = g.y[k];
+        int travelDir = g.travelDir[k];
+        int flight = g.flight[k];
+        Fixed speed = g.speed[k];
+        
+        if (flight == 0 || y >= top || y <= 0) //if flight path reaches 0 or reaches bottom/top of screen
+        {
+            if (y >= top)
+                travelDir = DOWN_LEFT;
+            else if (y <= 0)
+                travelDir = UP_LEFT;
+            else if (Kind::RANDOM_FLIGHTS)
+                travelDir = dirs[j];
+            if (Kind::RANDOM_FLIGHTS)
+                flight = flights[j];
+        }
+        
+        //fire, or charge, only when the player is in the line of fire
+        int fireTag = GAMEOBJECT;
+        const bool inLine = !aimed || (tick.playerX < x && tick.playerY >= y - lineOfFire && tick.playerY <= y + lineOfFire);
+        if (inLine && shots[j] < 1)
+            fireTag = Kind::SHOT;
+        else if (Kind::CHARGES && aimed && inLine && charges[j] < 1)
+        {
+            travelDir = DUE_LEFT;
+            flight = VIEW_WIDTH;
+            speed = 5 * FIXED_ONE;
+        }
+        
+        //firing takes the alien's turn; otherwise it moves a step along its flight
+        Fixed destX = x;
+        Fixed destY = y;
+        if (fireTag == GAMEOBJECT)
+        {
+            destX = x - speed;
+            if (travelDir == UP_LEFT)
+                destY = y + speed;
+            else if (travelDir == DOWN_LEFT)
+                destY = y - speed;
+            flight--;
+        }
+        g.travelDir[k] = travelDir;
+        g.flight[k] = flight;
+        g.speed[k] = speed;
+        g.fireTag[k] = fireTag;
+        g.destX[k] = destX;
+        g.destY[k] = destY;
+    }
+}
+
+void planAliens(int archetype, ActorStore::Group& g, size_t firstBlock, size_t endBlock, const TickInfo& tick)
+{
+    for (size_t b = firstBlock; b < endBlock; b++)
+    {
+        RandomGenerator rng(tick.key ^ ((unsigned long long)archetype << 32 | b));
+        const size_t begin = b * ALIEN_BLOCK;
+        const size_t end = (begin + ALIEN_BLOCK < g.size()) ? begin + ALIEN_BLOCK : g.size();
+        switch (archetype)
+        {
+            case ARCH_SMALLGON:
+                planBlock<SmallgonFlight>(g, begin, end, tick, rng);
+                break;
+            case ARCH_SMOREGON:
+                planBlock<SmoregonFlight>(g, begin, end, tick, rng);
+                break;
+            case ARCH_SNAGGLEGON:
+                planBlock<SnagglegonFlight>(g, begin, end, tick, rng);
+                break;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef ALIENKERNELS_H_
+#define ALIENKERNELS_H_
+
+#include "ActorStore.h"
+#include "Fixed.h"
+#include <cstddef>
+
+//Snapshot of the tick that aliens plan their moves from (see StudentWorld::planActors),
+//with everything that depends only on the level worked out once, not once per alien
+struct TickInfo
+{
+    Fixed playerX;
+    Fixed playerY;
+    int turnipOdds;  //an alien in line with the player fires a turnip one tick in turnipOdds,
+    int torpedoOdds; //a Snagglegon fires a torpedo one tick in torpedoOdds,
+    int chargeOdds;  //and a Smoregon that didn't fire charges one tick in chargeOdds
+    int fireOdds; //stress runs: aliens fire one tick in fireOdds wherever the player is, or by the usual rules if 0
+    unsigned long long key; //fresh every tick: each block of aliens derives its own random stream from it
+};
+
+TickInfo makeTickInfo(Fixed playerX, Fixed playerY, int level, int fireOdds, unsigned long long key);
+
+//Aliens are planned in blocks of ALIEN_BLOCK slots.  Each block draws its random
+//numbers from its own stream, a fixed number per alien, in one go, so a block
+//comes out the same whichever thread plans it and whatever its aliens decide.
+const size_t ALIEN_BLOCK = 64;
+
+inline size_t alienBlocks(size_t aliens)
+{
+    return (aliens + ALIEN_BLOCK - 1) / ALIEN_BLOCK;
+}
+
+//Runs the flight kernel for archetype (one of the alien archetypes) over blocks
+//[firstBlock, endBlock) of its group: picks each alien's flight, whether it fires,
+//and where it moves to, reading and writing only the group's arrays
+void planAliens(int archetype, ActorStore::Group& g, size_t firstBlock, size_t endBlock, const TickInfo& tick);
+
+#endif // ALIENKERNELS_H_
@@ -0,0 +1,136 @@
+#include "HeadlessController.h"
+#include "StudentWorld.h"
+#include "WorkerPool.h"
+#include "GameConstants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+using namespace std;
+
+  // Plays N independent games side by side, one StudentWorld per game, and
+  // reports how each one ended.  Usage:
+  //   NachenBlasterBatch [-worlds N] [-threads T] [-ticks MAX] [-script KEYS] [-seed S] [-broadphase grid|sweep]
+  // World k is seeded with S+k and plays until game over or MAX ticks.
+  // Every world has its own controller (scripted keys, no sound), actor
+  // registry and random generator, so worlds share nothing and the outcome of
+  // each one doesn't depend on T.
+
+const int DEFAULT_WORLDS = 64;
+const long DEFAULT_TICKS = 20000;
+const string DEFAULT_SCRIPT = " ....w ....s";
+
+struct WorldResult
+{
+	unsigned long seed;
+	long ticks;
+	unsigned int score;
+	unsigned int level;
+	int lives;
+	bool gameOver;
+};
+
+static WorldResult runWorld(unsigned long seed, long maxTicks, const string& script, bool sweep)
+{
+	HeadlessController controller(script);
+	StudentWorld world("", seed);
+	world.useSweepAndPrune(sweep);
+	world.setController(&controller);
+	world.init();
+
+	WorldResult r = {seed, 0, 0, 1, 0, false};
+	while (r.ticks < maxTicks  &&  !controller.quitRequested())
+	{
+		controller.nextTick();
+		int status = world.move();
+		r.ticks++;
+		if (status == GWSTATUS_PLAYER_DIED)
+		{
+			world.cleanUp();
+			if (world.isGameOver())
+			{
+				r.gameOver = true;
+				break;
+			}
+			world.init();
+		}
+		else if (status == GWSTATUS_FINISHED_LEVEL)
+		{
+			world.advanceToNextLevel();
+			world.cleanUp();
+			world.init();
+		}
+	}
+	r.score = world.getScore();
+	r.level = world.getLevel();
+	r.lives = world.getLives();
+	return r;
+}
+
+int main(int argc, char* argv[])
+{
+	int worlds = DEFAULT_WORLDS;
+	int threads = (int)thread::hardware_concurrency();
+	long maxTicks = DEFAULT_TICKS;
+	string script = DEFAULT_SCRIPT;
+	unsigned long seed = 1;
+	bool sweep = false;
+	for (int k = 1; k + 1 < argc; k += 2)
+	{
+		string opt = argv[k];
+		if (opt == "-worlds")
+			worlds = atoi(argv[k+1]);
+		else if (opt == "-threads")
+			threads = atoi(argv[k+1]);
+		else if (opt == "-ticks")
+			maxTicks = atol(argv[k+1]);
+		else if (opt == "-script")
+			script = argv[k+1];
+		else if (opt == "-seed")
+			seed = strtoul(argv[k+1], nullptr, 10);
+		else if (opt == "-broadphase")
+			sweep = (string(argv[k+1]) == "sweep");
+		else
+		{
+			cout << "Unknown option " << opt << endl;
+			return 1;
+		}
+	}
+	if (worlds < 1)
+		worlds = 1;
+	if (threads < 1)
+		threads = 1;
+
+	vector<WorldResult> results(worlds);
+	WorkerPool pool(threads);
+	auto start = chrono::steady_clock::now();
+	pool.run(results.size(), [&](size_t begin, size_t end) {
+		for (size_t k = begin; k < end; k++)
+			results[k] = runWorld(seed + k, maxTicks, script, sweep);
+	});
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	long totalTicks = 0;
+	unsigned long totalScore = 0;
+	int gamesOver = 0;
+	cout << "  seed     ticks   score  level  lives" << endl;
+	for (const WorldResult& r : results)
+	{
+		cout << setw(6) << r.seed << setw(10) << r.ticks << setw(8) << r.score << setw(7) << r.level
+			 << setw(7) << r.lives << (r.gameOver ? "  game over" : "") << endl;
+		totalTicks += r.ticks;
+		totalScore += r.score;
+		if (r.gameOver)
+			gamesOver++;
+	}
+	cout << "worlds:      " << worlds << endl;
+	cout << "threads:     " << pool.threads() << endl;
+	cout << "ticks:       " << totalTicks << endl;
+	cout << "seconds:     " << secs << endl;
+	cout << "ticks/sec:   " << (secs > 0 ? totalTicks / secs : 0) << endl;
+	cout << "games over:  " << gamesOver << endl;
+	cout << "mean score:  " << (double)totalScore / worlds << endl;
+}
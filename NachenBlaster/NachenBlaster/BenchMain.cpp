@@ -0,0 +1,380 @@
+#include "HeadlessController.h"
+#include "StudentWorld.h"
+#include "Actor.h"
+#include "ActorStore.h"
+#include "ObjectPool.h"
+#include "RandomGenerator.h"
+#include "GameConstants.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+using namespace std;
+
+  // Times the simulation's hot paths on synthetic worlds of a given size and
+  // prints the results as JSON.  Usage:
+  //   NachenBlasterBench [-sizes N,N,...] [-mix W,W,...] [-seed S] [-broadphase grid|sweep] [-out FILE]
+  // Each size N is a world holding N actors (on top of the player) at random
+  // places on screen.  The mix gives the relative number of
+  // each kind of actor, one weight per archetype in ActorStore.h order.
+  // Benchmarks, and what one op is:
+  //   collision          Actor::collision on one random pair of actors
+  //   processCollision   StudentWorld::processCollision for one actor
+  //   removeDead         one removeDeadGameObjects() call after a tenth of the actors die
+  //   spawnChurn         one addProjectile (applied, killed and removed) or addExplosion (applied, and cleared
+  //                      with the rest of its batch of N/10)
+  //   registry           one GraphObject added to and removed from a registry of N
+  //   move               one full tick
+  //   randInt            one StudentWorld::randInt draw (size 0: it doesn't depend on N)
+  // A world of the same size and seed is the same world on every run.
+
+const string DEFAULT_SIZES = "10,100,1000,10000,100000";
+const double DEFAULT_MIX[NUM_ARCHETYPES] = {2, 2, 1, 2, 2, 1, 1, 1, 1};
+const long OPS_PER_SIZE = 1000000;  // roughly how many ops each benchmark runs at each size
+
+using Clock = chrono::steady_clock;
+
+struct BenchResult
+{
+	string name;
+	size_t actors;
+	long ops;
+	double seconds;
+};
+
+  // Just enough of a GraphObject to put in a registry
+class BenchSprite : public GraphObject
+{
+  public:
+	BenchSprite(GraphObjectRegistry& registry, double x, double y, int depth)
+	 : GraphObject(registry, IID_STAR, x, y, 0, 1.0, depth)
+	{
+	}
+};
+
+static double secondsSince(Clock::time_point start)
+{
+	return chrono::duration<double>(Clock::now() - start).count();
+}
+
+  // Number of passes over N things that adds up to about OPS_PER_SIZE ops,
+  // but at least minPasses
+static long passesFor(size_t n, long minPasses)
+{
+	long passes = OPS_PER_SIZE / (long)(n > 0 ? n : 1);
+	return passes < minPasses ? minPasses : passes;
+}
+
+static void randomSpot(RandomGenerator& rng, double& x, double& y)
+{
+	x = rng.randDouble(0, VIEW_WIDTH-1);
+	y = rng.randDouble(0, VIEW_HEIGHT-1);
+}
+
+  // Adds n actors to world, split between archetypes by the weights in mix
+static void populate(StudentWorld& world, RandomGenerator& rng, size_t n, const double mix[NUM_ARCHETYPES])
+{
+	double total = 0;
+	for (int arch = 0; arch < NUM_ARCHETYPES; arch++)
+		total += mix[arch];
+	double sum = 0;
+	size_t placed = 0;
+	for (int arch = 0; arch < NUM_ARCHETYPES; arch++)
+	{
+		sum += mix[arch];
+		size_t upTo = (total > 0) ? (size_t)(n * sum / total + .5) : 0;
+		for ( ; placed < upTo; placed++)
+		{
+			double x, y;
+			randomSpot(rng, x, y);
+			world.spawnActor(arch, x, y);
+		}
+	}
+}
+
+static void allActors(StudentWorld& world, vector<Actor*>& out)
+{
+	out.clear();
+	for (int arch = 0; arch < NUM_ARCHETYPES; arch++)
+	{
+		const ActorStore::Group& g = world.getActors().group(arch);
+		out.insert(out.end(), g.actor.begin(), g.actor.end());
+	}
+}
+
+static BenchResult benchCollision(StudentWorld& world, RandomGenerator& rng, size_t n)
+{
+	vector<Actor*> actors;
+	allActors(world, actors);
+	vector<pair<Actor*, Actor*>> pairs(actors.size());
+	for (auto& p : pairs)
+	{
+		p.first = actors[rng.randInt(0, (int)actors.size() - 1)];
+		p.second = actors[rng.randInt(0, (int)actors.size() - 1)];
+	}
+	long passes = passesFor(pairs.size(), 1);
+	long hits = 0;
+	Clock::time_point start = Clock::now();
+	for (long pass = 0; pass < passes; pass++)
+		for (const auto& p : pairs)
+			hits += p.first->collision(p.second);
+	double secs = secondsSince(start);
+	if (hits < 0)  // keeps the loop from being optimized away
+		cout << hits;
+	return BenchResult{"collision", n, passes * (long)pairs.size(), secs};
+}
+
+static BenchResult benchProcessCollision(StudentWorld& world, size_t n)
+{
+	vector<Actor*> actors;
+	allActors(world, actors);
+	long passes = passesFor(actors.size(), 1);
+	long hits = 0;
+	Clock::time_point start = Clock::now();
+	for (long pass = 0; pass < passes; pass++)
+	{
+		for (Actor* a : actors)
+			hits += world.processCollision(a);
+		world.discardCommands();  // the damage it queued
+	}
+	double secs = secondsSince(start);
+	if (hits < 0)
+		cout << hits;
+	return BenchResult{"processCollision", n, passes * (long)actors.size(), secs};
+}
+
+static BenchResult benchRemoveDead(StudentWorld& world, RandomGenerator& rng, size_t n)
+{
+	long passes = passesFor(n, 3) / 10;
+	if (passes < 3)
+		passes = 3;
+	vector<Actor*> actors;
+	vector<int> killed;
+	double secs = 0;
+	for (long pass = 0; pass < passes; pass++)
+	{
+		allActors(world, actors);
+		killed.clear();
+		for (Actor* a : actors)
+		{
+			if (rng.randInt(0, 9) == 0)
+			{
+				killed.push_back(a->getArchetype());
+				a->die();
+			}
+		}
+		Clock::time_point start = Clock::now();
+		world.removeDeadGameObjects();
+		secs += secondsSince(start);
+		for (int arch : killed)  // back to size for the next pass
+		{
+			double x, y;
+			randomSpot(rng, x, y);
+			world.spawnActor(arch, x, y);
+		}
+	}
+	return BenchResult{"removeDead", n, passes, secs};
+}
+
+static BenchResult benchSpawnChurn(StudentWorld& world, RandomGenerator& rng, size_t n)
+{
+	const size_t batch = (n / 10 > 0) ? n / 10 : 1;
+	long passes = passesFor(2 * batch, 3);
+	const ActorStore::Group& cabbages = world.getActors().group(ARCH_CABBAGE);
+	Clock::time_point start = Clock::now();
+	for (long pass = 0; pass < passes; pass++)
+	{
+		const size_t oldCabbages = cabbages.size();
+		for (size_t k = 0; k < batch; k++)
+		{
+			double x, y;
+			randomSpot(rng, x, y);
+			world.addProjectile(x, y, IID_CABBAGE);
+			world.addExplosion(x, y);
+		}
+		world.applyCommands();
+		for (size_t k = oldCabbages; k < cabbages.size(); k++)
+			cabbages.actor[k]->die();
+		world.removeDeadGameObjects();
+		world.clearEffects();  // so each pass spawns into an empty ring, not one kept full
+	}
+	double secs = secondsSince(start);
+	return BenchResult{"spawnChurn", n, passes * 2 * (long)batch, secs};
+}
+
+static BenchResult benchRegistry(RandomGenerator& rng, size_t n)
+{
+	const size_t batch = (n / 10 > 0) ? n / 10 : 1;
+	GraphObjectRegistry registry;
+	ObjectPool<BenchSprite> pool(n + batch);
+	vector<BenchSprite*> resident(n);
+	for (size_t k = 0; k < n; k++)
+		resident[k] = pool.create(registry, 0, 0, rng.randInt(0, GraphObjectRegistry::NUM_DEPTHS - 1));
+	vector<BenchSprite*> churn(batch);
+	long passes = passesFor(batch, 3);
+	Clock::time_point start = Clock::now();
+	for (long pass = 0; pass < passes; pass++)
+	{
+		for (size_t k = 0; k < batch; k++)
+			churn[k] = pool.create(registry, 0, 0, (int)(k % GraphObjectRegistry::NUM_DEPTHS));
+		for (size_t k = batch; k > 1; k--)  // removed in a shuffled order
+			swap(churn[k-1], churn[rng.randInt(0, (int)k - 1)]);
+		for (BenchSprite* s : churn)
+			pool.destroy(s);
+	}
+	double secs = secondsSince(start);
+	for (BenchSprite* s : resident)
+		pool.destroy(s);
+	return BenchResult{"registry", n, passes * (long)batch, secs};
+}
+
+  // Enough ticks to add up to about OPS_PER_SIZE actor updates.  Crowded
+  // worlds kill the player quickly; the world is rebuilt (untimed) whenever a
+  // tick ends the life or the level.
+static BenchResult benchMove(StudentWorld& world, HeadlessController& controller, RandomGenerator& rng,
+							 size_t n, const double mix[NUM_ARCHETYPES])
+{
+	long maxTicks = passesFor(n, 3);
+	if (maxTicks > 1000)
+		maxTicks = 1000;
+	double secs = 0;
+	for (long tick = 0; tick < maxTicks; tick++)
+	{
+		controller.nextTick();
+		Clock::time_point start = Clock::now();
+		int status = world.move();
+		secs += secondsSince(start);
+		if (status != GWSTATUS_CONTINUE_GAME)
+		{
+			world.cleanUp();
+			world.init();
+			populate(world, rng, n, mix);
+		}
+	}
+	return BenchResult{"move", n, maxTicks, secs};
+}
+
+static BenchResult benchRandInt(StudentWorld& world)
+{
+	const long draws = 10 * OPS_PER_SIZE;
+	long sum = 0;
+	Clock::time_point start = Clock::now();
+	for (long k = 0; k < draws; k++)
+		sum += world.randInt(0, 14);
+	double secs = secondsSince(start);
+	if (sum < 0)
+		cout << sum;
+	return BenchResult{"randInt", 0, draws, secs};
+}
+
+static bool parseList(const string& list, vector<double>& out)
+{
+	out.clear();
+	stringstream ss(list);
+	string item;
+	while (getline(ss, item, ','))
+	{
+		char* end;
+		double v = strtod(item.c_str(), &end);
+		if (item.empty() || *end != '\0' || v < 0)
+			return false;
+		out.push_back(v);
+	}
+	return !out.empty();
+}
+
+static void writeJson(ostream& out, unsigned long seed, bool sweep, const vector<BenchResult>& results)
+{
+	out << "{\n  \"seed\": " << seed << ",\n  \"broadphase\": \"" << (sweep ? "sweep" : "grid")
+		<< "\",\n  \"results\": [\n";
+	for (size_t k = 0; k < results.size(); k++)
+	{
+		const BenchResult& r = results[k];
+		out << "    {\"name\": \"" << r.name << "\", \"actors\": " << r.actors << ", \"ops\": " << r.ops
+			<< ", \"seconds\": " << r.seconds << ", \"nsPerOp\": " << (r.ops > 0 ? r.seconds * 1e9 / r.ops : 0)
+			<< "}" << (k + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n}" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	string sizeList = DEFAULT_SIZES;
+	vector<double> mix(DEFAULT_MIX, DEFAULT_MIX + NUM_ARCHETYPES);
+	unsigned long seed = 1;
+	bool sweep = false;
+	string outPath;
+	for (int k = 1; k + 1 < argc; k += 2)
+	{
+		string opt = argv[k];
+		if (opt == "-sizes")
+			sizeList = argv[k+1];
+		else if (opt == "-mix")
+		{
+			if (!parseList(argv[k+1], mix) || mix.size() != NUM_ARCHETYPES)
+			{
+				cout << "-mix needs " << NUM_ARCHETYPES << " weights" << endl;
+				return 1;
+			}
+		}
+		else if (opt == "-seed")
+			seed = strtoul(argv[k+1], nullptr, 10);
+		else if (opt == "-broadphase")
+			sweep = (string(argv[k+1]) == "sweep");
+		else if (opt == "-out")
+			outPath = argv[k+1];
+		else
+		{
+			cout << "Unknown option " << opt << endl;
+			return 1;
+		}
+	}
+	vector<double> sizes;
+	if (!parseList(sizeList, sizes))
+	{
+		cout << "Bad -sizes list " << sizeList << endl;
+		return 1;
+	}
+
+	vector<BenchResult> results;
+	for (double size : sizes)
+	{
+		const size_t n = (size_t)size;
+		HeadlessController controller(".");
+		StudentWorld world("", seed);
+		world.useSweepAndPrune(sweep);
+		world.setController(&controller);
+		world.init();
+		RandomGenerator rng(seed);
+		populate(world, rng, n, mix.data());
+
+		  // read-only benchmarks first, then the ones that churn actors, and
+		  // move() last since it changes the world for good
+		results.push_back(benchCollision(world, rng, n));
+		results.push_back(benchProcessCollision(world, n));
+		results.push_back(benchRegistry(rng, n));
+		results.push_back(benchSpawnChurn(world, rng, n));
+		results.push_back(benchRemoveDead(world, rng, n));
+		results.push_back(benchMove(world, controller, rng, n, mix.data()));
+	}
+	{
+		StudentWorld world("", seed);
+		results.push_back(benchRandInt(world));
+	}
+
+	if (outPath.empty())
+		writeJson(cout, seed, sweep, results);
+	else
+	{
+		ofstream out(outPath);
+		if (!out)
+		{
+			cout << "Cannot write " << outPath << endl;
+			return 1;
+		}
+		writeJson(out, seed, sweep, results);
+	}
+}
@@ -0,0 +1,103 @@
+#include "CollisionGrid.h"
+#include "Actor.h"
+using namespace std;
+
+void CollisionCandidates::add(Actor* a, unsigned long spawnSeq)
+{
+    actor.push_back(a);
+    seq.push_back(spawnSeq);
+    x.push_back(a->getFixedX());
+    y.push_back(a->getFixedY());
+    radius.push_back(a->getFixedRadius());
+}
+
+void CollisionCandidates::clear()
+{
+    actor.clear();
+    seq.clear();
+    x.clear();
+    y.clear();
+    radius.clear();
+}
+
+CollisionGrid::CollisionGrid()
+: m_maxRadius(0)
+{}
+
+int CollisionGrid::cellX(double x)
+{
+    int cx = (int)(x / CELL_SIZE);
+    if (x < 0 || cx < 0) return 0;
+    return (cx >= CELLS_X) ? CELLS_X - 1 : cx;
+}
+
+int CollisionGrid::cellY(double y)
+{
+    int cy = (int)(y / CELL_SIZE);
+    if (y < 0 || cy < 0) return 0;
+    return (cy >= CELLS_Y) ? CELLS_Y - 1 : cy;
+}
+
+int CollisionGrid::cellOf(const Actor* a)
+{
+    return cellY(a->getY()) * CELLS_X + cellX(a->getX());
+}
+
+void CollisionGrid::insert(Actor* a)
+{
+    const int cell = cellOf(a);
+    m_cells[cell].push_back(Entry{a, a->getSpawnSeq()});
+    a->setBroadphaseSlot(cell);
+    if (a->getRadius() > m_maxRadius)
+        m_maxRadius = a->getRadius();
+}
+
+void CollisionGrid::remove(Actor* a)
+{
+    const int cell = a->getBroadphaseSlot();
+    if (cell < 0) return;
+    vector<Entry>& v = m_cells[cell];
+    for (size_t k = 0; k < v.size(); k++)
+    {
+        if (v[k].actor == a)
+        {
+            v[k] = v.back(); //order within a cell doesn't matter: seq keeps spawn order
+            v.pop_back();
+            break;
+        }
+    }
+    a->setBroadphaseSlot(-1);
+}
+
+void CollisionGrid::update(Actor* a)
+{
+    const int cell = a->getBroadphaseSlot();
+    if (cell < 0 || cell == cellOf(a)) //not tracked, or still in the same cell
+        return;
+    vector<Entry>& v = m_cells[cell];
+    for (size_t k = 0; k < v.size(); k++)
+    {
+        if (v[k].actor == a)
+        {
+            const int newCell = cellOf(a);
+            m_cells[newCell].push_back(v[k]);
+            v[k] = v.back();
+            v.pop_back();
+            a->setBroadphaseSlot(newCell);
+            return;
+        }
+    }
+}
+
+void CollisionGrid::clear()
+{
+    for (vector<Entry>& v : m_cells)
+    {
+        for (Entry& e : v)
+            e.actor->setBroadphaseSlot(-1);
+        v.clear(); //keeps capacity for the next level
+    }
+    m_maxRadius = 0;
+}
+
+double CollisionGrid::getMaxRadius() const {return m_maxRadius;}
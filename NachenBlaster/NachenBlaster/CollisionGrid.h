@@ -0,0 +1,72 @@
+#ifndef COLLISIONGRID_H_
+#define COLLISIONGRID_H_
+
+#include "GameConstants.h"
+#include "Fixed.h"
+#include <vector>
+
+class Actor;
+
+//Candidates gathered from the grid, packed field by field for the narrow phase (CollisionKernel.h)
+struct CollisionCandidates
+{
+    std::vector<Actor*> actor;
+    std::vector<unsigned long> seq;
+    std::vector<Fixed> x;
+    std::vector<Fixed> y;
+    std::vector<Fixed> radius;
+
+    void add(Actor* a, unsigned long spawnSeq);
+    void clear(); //keeps capacity
+    size_t size() const
+    {
+        return actor.size();
+    }
+};
+
+//Uniform grid over the view used to find collision candidates near a point.
+//Actors are filed by their center; positions off screen are clamped into the
+//border cells, so every actor is always in exactly one cell.
+//Each entry keeps its actor's spawn sequence number, so callers can pick the
+//earliest-spawned hit just like a scan of the actor list would.
+class CollisionGrid
+{
+public:
+    static const int CELL_SIZE = 32;
+    static const int CELLS_X = VIEW_WIDTH / CELL_SIZE;
+    static const int CELLS_Y = VIEW_HEIGHT / CELL_SIZE;
+
+    CollisionGrid();
+    void insert(Actor* a);
+    void remove(Actor* a);
+    void update(Actor* a); //call after a moves
+    void clear();
+    double getMaxRadius() const;
+
+    //Calls f(actor, seq) for every actor filed in a cell within reach of (x, y)
+    template<typename Func>
+    void forEachNear(double x, double y, double reach, Func f) const
+    {
+        const int cx0 = cellX(x - reach), cx1 = cellX(x + reach);
+        const int cy0 = cellY(y - reach), cy1 = cellY(y + reach);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++)
+                for (const Entry& e : m_cells[cy * CELLS_X + cx])
+                    f(e.actor, e.seq);
+    }
+
+private:
+    struct Entry
+    {
+        Actor* actor;
+        unsigned long seq;
+    };
+    std::vector<Entry> m_cells[CELLS_X * CELLS_Y];
+    double m_maxRadius;
+
+    static int cellX(double x);
+    static int cellY(double y);
+    static int cellOf(const Actor* a);
+};
+
+#endif // COLLISIONGRID_H_
@@ -0,0 +1,35 @@
+#include "CollisionKernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+uint64_t circleHitMask(Fixed qx, Fixed qy, Fixed qr,
+                       const Fixed* xs, const Fixed* ys, const Fixed* rs, int count)
+{
+    uint64_t mask = 0;
+    int k = 0;
+#if defined(__AVX2__)
+    //four circles at a time, each widened to a 64-bit lane so the squares can't overflow
+    const __m256i vqx = _mm256_set1_epi64x(qx);
+    const __m256i vqy = _mm256_set1_epi64x(qy);
+    const __m256i vqr = _mm256_set1_epi64x(qr);
+    for ( ; k + 4 <= count; k += 4)
+    {
+        const __m256i dx = _mm256_sub_epi64(vqx, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(xs + k))));
+        const __m256i dy = _mm256_sub_epi64(vqy, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(ys + k))));
+        const __m256i reach = _mm256_add_epi64(vqr, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(rs + k))));
+        //mul_epi32 multiplies the low 32 bits of each lane, which hold the whole difference
+        const __m256i dist2 = _mm256_add_epi64(_mm256_mul_epi32(dx, dx), _mm256_mul_epi32(dy, dy));
+        const __m256i reach2 = _mm256_mul_epi32(reach, reach);
+        const __m256i lhs = _mm256_slli_epi64(dist2, 4);                             //16 * dist^2
+        const __m256i rhs = _mm256_add_epi64(_mm256_slli_epi64(reach2, 3), reach2);  //9 * reach^2
+        const __m256i hit = _mm256_cmpgt_epi64(rhs, lhs);
+        mask |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(hit)) << k;
+    }
+#endif
+    for ( ; k < count; k++) //scalar fallback and leftovers
+        if (circlesCollide(qx, qy, qr, xs[k], ys[k], rs[k]))
+            mask |= (uint64_t)1 << k;
+    return mask;
+}
@@ -0,0 +1,27 @@
+#ifndef COLLISIONKERNEL_H_
+#define COLLISIONKERNEL_H_
+
+#include "Fixed.h"
+#include <cstdint>
+
+//Narrow-phase circle tests on 16.16 fixed-point positions and radii.  Two
+//circles collide when the distance between their centers is under .75 times
+//the sum of their radii, which in integers is 16 * dist^2 < 9 * (r1 + r2)^2;
+//both functions compute exactly that in 64 bits, so they always agree.
+
+//Does the circle (x1, y1, r1) collide with (x2, y2, r2)?
+inline bool circlesCollide(Fixed x1, Fixed y1, Fixed r1, Fixed x2, Fixed y2, Fixed r2)
+{
+    const int64_t dx = (int64_t)x1 - x2;
+    const int64_t dy = (int64_t)y1 - y2;
+    const int64_t reach = (int64_t)r1 + r2;
+    return 16 * (dx * dx + dy * dy) < 9 * reach * reach;
+}
+
+//Tests the query circle (qx, qy, qr) against count <= 64 packed circles
+//(xs[k], ys[k], rs[k]) and returns a mask with bit k set when circle k collides.
+//Uses AVX2 when the compiler targets it, and plain C++ otherwise.
+uint64_t circleHitMask(Fixed qx, Fixed qy, Fixed qr,
+                       const Fixed* xs, const Fixed* ys, const Fixed* rs, int count);
+
+#endif // COLLISIONKERNEL_H_
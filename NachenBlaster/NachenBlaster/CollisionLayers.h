@@ -0,0 +1,43 @@
+#ifndef COLLISIONLAYERS_H_
+#define COLLISIONLAYERS_H_
+
+//Every actor sits on one collision layer.  An actor can only be hit by actors
+//whose layer is in its hit mask, so most candidate pairs are rejected with a
+//single AND, and actors with an empty mask never need to be queried at all.
+//New kinds of actors just pick a layer; the rules live in the table below.
+const unsigned int LAYER_NONE        = 0;      //stars, explosions, goodies
+const unsigned int LAYER_PLAYER      = 1 << 0;
+const unsigned int LAYER_ALIEN       = 1 << 1;
+const unsigned int LAYER_PLAYER_SHOT = 1 << 2; //cabbages, player torpedoes
+const unsigned int LAYER_ALIEN_SHOT  = 1 << 3; //turnips, alien torpedoes
+
+struct CollisionRule
+{
+    unsigned int attacker;
+    unsigned int target;
+};
+
+//Who can hit whom.  Rules are one-way: a cabbage hits an alien when the
+//cabbage moves into it, but an alien moving into a cabbage hits nothing.
+constexpr CollisionRule COLLISION_RULES[] = {
+    { LAYER_ALIEN,       LAYER_PLAYER },
+    { LAYER_ALIEN_SHOT,  LAYER_PLAYER },
+    { LAYER_PLAYER,      LAYER_ALIEN  },
+    { LAYER_PLAYER_SHOT, LAYER_ALIEN  },
+};
+
+//The layers that can hit an actor on the given layer, folded from the table at compile time
+constexpr unsigned int hitMaskFor(unsigned int layer)
+{
+    unsigned int mask = 0;
+    for (const CollisionRule& r : COLLISION_RULES)
+        if (r.target == layer)
+            mask |= r.attacker;
+    return mask;
+}
+
+static_assert(hitMaskFor(LAYER_PLAYER) == (LAYER_ALIEN | LAYER_ALIEN_SHOT), "player collision rules");
+static_assert(hitMaskFor(LAYER_ALIEN) == (LAYER_PLAYER | LAYER_PLAYER_SHOT), "alien collision rules");
+static_assert(hitMaskFor(LAYER_NONE) == 0, "unlayered actors can't be hit");
+
+#endif // COLLISIONLAYERS_H_
@@ -0,0 +1,55 @@
+#ifndef COMMANDBUFFER_H_
+#define COMMANDBUFFER_H_
+
+#include "ActorHandle.h"
+#include <vector>
+
+//Effects actors produce while they update, recorded instead of applied.
+//StudentWorld applies the whole buffer, in order, once every actor has moved.
+const int CMD_SPAWN_PROJECTILE = 0; //value = projectile tag, at (x, y)
+const int CMD_SPAWN_EXPLOSION  = 1; //at (x, y)
+const int CMD_SPAWN_GOODIE     = 2; //value = DROP_* rule passed to addGoodieMaybe, at (x, y)
+const int CMD_DAMAGE           = 3; //target suffers damage from value (the enemy's tag)
+const int CMD_SCORE            = 4; //value = points
+const int CMD_SOUND            = 5; //value = sound ID
+const int CMD_ALIEN_DESTROYED  = 6;
+const int CMD_GOODIE           = 7; //value = archetype of the goodie whose benefit the player gets
+
+struct Command
+{
+    int type;
+    int value;
+    double x;
+    double y;
+    ActorHandle target; //may have gone stale by the time the command is applied
+};
+
+class CommandBuffer
+{
+public:
+    void push(int type, int value, double x = 0, double y = 0, ActorHandle target = NO_ACTOR)
+    {
+        m_commands.push_back(Command{type, value, x, y, target});
+    }
+
+    size_t size() const
+    {
+        return m_commands.size();
+    }
+
+    //By value: applying a command may push more
+    Command operator[](size_t k) const
+    {
+        return m_commands[k];
+    }
+
+    void clear() //keeps capacity for the next tick
+    {
+        m_commands.clear();
+    }
+
+private:
+    std::vector<Command> m_commands;
+};
+
+#endif // COMMANDBUFFER_H_
@@ -0,0 +1,27 @@
+#ifndef FIXED_H_
+#define FIXED_H_
+
+#include <cstdint>
+#include <math.h>
+
+//16.16 fixed point: positions and sizes are whole multiples of 1/65536, held
+//in ints.  Every step the game takes (whole pixels, .75, 1.75, size 1.5, ...)
+//is exact in it, so a simulation run gives bit-identical results on every
+//compiler and platform, and collision tests are integer math.
+//Doubles only come in at the edges: spawn points, snapshots and drawing.
+typedef int32_t Fixed;
+
+const int FIXED_SHIFT = 16;
+const Fixed FIXED_ONE = 1 << FIXED_SHIFT;
+
+inline Fixed toFixed(double v) //rounds to the nearest step
+{
+    return (Fixed)lround(v * FIXED_ONE);
+}
+
+inline double fromFixed(Fixed f) //always exact
+{
+    return f / (double)FIXED_ONE;
+}
+
+#endif // FIXED_H_
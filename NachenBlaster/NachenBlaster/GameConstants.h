@@ -65,7 +65,8 @@ const int GWSTATUS_LEVEL_ERROR	 = 4;
 
 const int NUM_TEST_PARAMS = 1;
 
-  // Return a uniformly distributed random int from min to max, inclusive
+  // Return a uniformly distributed random int from min to max, inclusive.
+  // Game objects draw from their StudentWorld's own generator instead.
 
 inline
 int randInt(int min, int max)
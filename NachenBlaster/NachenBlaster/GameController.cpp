@@ -42,9 +42,10 @@ static const double SCORE_Y = 3.8;
 static const double SCORE_Z = -10;
 
 static const int MS_PER_FRAME = 5;
+static const int REWIND_TICKS = 100; // how far back each press of the rewind key goes, about a second
 
 static void drawPrompt(string mainMessage, string secondMessage);
-static void drawScoreAndLives(string);
+static void drawScoreAndLives(const string&);
 
 enum GameController::GameControllerState : int {
     welcome, init, makemove, animate, contgame, finishedlevel, cleanup, gameover, prompt, quit, not_applicable
@@ -124,9 +125,9 @@ static void timerFuncCallback(int)
     glutTimerFunc(MS_PER_FRAME, timerFuncCallback, 0);
 }
 
-void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle)
+void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle, WorldController* worldController)
 {
-    gw->setController(this);
+    gw->setController(worldController != nullptr ? worldController : this);
     m_gw = gw;
     setGameState(welcome);
     m_lastKeyHit = INVALID_KEY;
@@ -165,11 +166,19 @@ void GameController::keyboardEvent(unsigned char key, int /* x */, int /* y */)
         case 't':            m_lastKeyHit = KEY_PRESS_TAB;    break;
         case 'f':            m_singleStep = true;            break;
         case 'r':            m_singleStep = false;            break;
+        case 'b':            rewind();                        break;
         case 'q': case 'Q': setGameState(quit);                break;
         default:            m_lastKeyHit = key;                break;
     }
 }
 
+void GameController::rewind()
+{
+      // only while a tick is on screen, not while the last frame of a life or level plays out
+    if (m_gameState == animate  &&  m_nextStateAfterAnimate == not_applicable)
+        m_gw->rewind(m_singleStep ? 1 : REWIND_TICKS);
+}
+
 void GameController::specialKeyboardEvent(int key, int /* x */, int /* y */)
 {
     switch (key)
@@ -331,12 +340,16 @@ void GameController::displayGamePlay()
 #pragma GCC diagnostic pop
 #endif
     
-    GraphObject::drawAllObjects(
+    m_gw->graphObjects().drawAll(
                                 [=](int imageID, int animationNumber, double x, double y, int angle, double size)
                                 {
                                     int frame = animationNumber % m_spriteManager.getNumFrames(imageID);
                                     m_spriteManager.plotSprite(imageID, frame, x, y, angle, size);
                                     
+                                },
+                                [=](int imageID, const double* x, const double* y, const double* size, size_t count)
+                                {
+                                    m_spriteManager.plotSprites(imageID, x, y, size, count);
                                 });
     
     drawScoreAndLives(m_gameStatText);
@@ -399,7 +412,7 @@ static void drawPrompt(string mainMessage, string secondMessage)
     glutSwapBuffers();
 }
 
-static void drawScoreAndLives(string gameStatText)
+static void drawScoreAndLives(const string& gameStatText)
 {
     static int RATE = 1;
     static GLfloat rgb[3] =
@@ -2,6 +2,7 @@
 #define GAMECONTROLLER_H_
 
 #include "SpriteManager.h"
+#include "GameWorld.h"
 #include <string>
 #include <map>
 #include <iostream>
@@ -10,14 +11,16 @@
 const int INVALID_KEY = 0;
 
 class GraphObject;
-class GameWorld;
 
-class GameController
+class GameController : public WorldController
 {
   public:
-	void run(int argc, char* argv[], GameWorld* gw, std::string windowTitle);
+	  // worldController is what gw talks to, if not this GameController itself
+	  // (e.g. a ReplayController feeding it recorded keys)
+	void run(int argc, char* argv[], GameWorld* gw, std::string windowTitle,
+			 WorldController* worldController = nullptr);
 
-	bool getLastKey(int& value)
+	virtual bool getLastKey(int& value)
 	{
 		if (m_lastKeyHit != INVALID_KEY)
 		{
@@ -28,11 +31,11 @@ class GameController
 		return false;
 	}
 
-	void playSound(int soundID);
+	virtual void playSound(int soundID);
 
-	void setGameStatText(std::string text)
+	virtual void setGameStatText(std::string_view text)
 	{
-		m_gameStatText = text;
+		m_gameStatText.assign(text.data(), text.size());  // reuses the string's buffer
 	}
 
 	void doSomething();
@@ -41,7 +44,7 @@ class GameController
 	void keyboardEvent(unsigned char key, int x, int y);
 	void specialKeyboardEvent(int key, int x, int y);
 
-	void quitGame();
+	virtual void quitGame();
 
 	  // Meyers singleton pattern
 	static GameController& getInstance()
@@ -73,6 +76,7 @@ private:
 	void setGameStateAfterPrompting(GameControllerState s,
 							std::string mainMessage, std::string secondMessage);
 
+	void rewind();
 	void initDrawersAndSounds();
 	void displayGamePlay();
 };
@@ -0,0 +1,158 @@
+#ifndef GAMERULES_H_
+#define GAMERULES_H_
+
+#include "GameConstants.h"
+#include "ActorStore.h"
+
+//The numbers behind the game's rules, as compile-time tables, so the code
+//that applies them looks them up instead of branching on tags.  A new kind of
+//actor gets its rules by adding rows here.
+
+const int NUM_TAGS = PLAYER + 1; //the image IDs and the additional tags in Actor.h
+
+//****** Damage ******//
+
+const int VICTIM_PLAYER = 0;
+const int VICTIM_ALIEN  = 1;
+const int NUM_VICTIMS   = 2;
+
+struct DamageRule
+{
+    int attacker; //tag of whatever did the hitting
+    int victim;
+    double damage; //hit points lost
+    bool lethal;   //destroys the victim whatever its hit points
+    int sound;     //played if the victim survives, or SOUND_NONE
+};
+
+constexpr DamageRule DAMAGE_RULES[] = {
+    { IID_SMALLGON,   VICTIM_PLAYER, 5,  false, SOUND_NONE  }, //aliens ramming the player
+    { IID_SMOREGON,   VICTIM_PLAYER, 5,  false, SOUND_NONE  },
+    { IID_SNAGGLEGON, VICTIM_PLAYER, 15, false, SOUND_NONE  },
+    { IID_TURNIP,     VICTIM_PLAYER, 2,  false, SOUND_BLAST },
+    { ALIEN_TORPEDO,  VICTIM_PLAYER, 8,  false, SOUND_BLAST },
+    { IID_CABBAGE,    VICTIM_ALIEN,  2,  false, SOUND_BLAST },
+    { PLAYER_TORPEDO, VICTIM_ALIEN,  8,  false, SOUND_BLAST },
+    { PLAYER,         VICTIM_ALIEN,  0,  true,  SOUND_NONE  }, //an alien that rams the player is destroyed
+};
+
+//What a hit does, for every (victim, attacker) pair; pairs without a rule do nothing
+struct Damage
+{
+    double damage;
+    bool lethal;
+    int sound;
+};
+
+struct DamageTable
+{
+    Damage hit[NUM_VICTIMS][NUM_TAGS];
+};
+
+constexpr DamageTable makeDamageTable()
+{
+    DamageTable t = {};
+    for (int v = 0; v < NUM_VICTIMS; v++)
+        for (int a = 0; a < NUM_TAGS; a++)
+            t.hit[v][a] = Damage{0, false, SOUND_NONE};
+    for (const DamageRule& r : DAMAGE_RULES)
+        t.hit[r.victim][r.attacker] = Damage{r.damage, r.lethal, r.sound};
+    return t;
+}
+
+constexpr DamageTable DAMAGE_TABLE = makeDamageTable();
+
+inline const Damage& damageFrom(int attacker, int victim)
+{
+    return DAMAGE_TABLE.hit[victim][attacker];
+}
+
+static_assert(DAMAGE_TABLE.hit[VICTIM_PLAYER][IID_SNAGGLEGON].damage == 15, "player damage rules");
+static_assert(DAMAGE_TABLE.hit[VICTIM_ALIEN][PLAYER].lethal, "alien damage rules");
+static_assert(DAMAGE_TABLE.hit[VICTIM_ALIEN][IID_TURNIP].damage == 0, "aliens don't hurt each other");
+
+//****** Drops ******//
+
+const int NO_DROP       = -1;
+const int DROP_SUPPLIES = 0;
+const int DROP_LIFE     = 1;
+
+//One kill in odds leaves a goodie, picked evenly from the first count archetypes listed
+struct DropRule
+{
+    int odds;
+    int count;
+    int goodies[2];
+};
+
+constexpr DropRule DROP_RULES[] = {
+    { 3, 2, { ARCH_REPAIR, ARCH_TORPEDO_GOODIE } }, //DROP_SUPPLIES
+    { 6, 1, { ARCH_EXTRA_LIFE } },                  //DROP_LIFE
+};
+
+//****** Aliens ******//
+
+struct AlienKind
+{
+    int imageID; //also its tag
+    int hits;    //hit points at level 1; each level after adds a tenth
+    double speed;
+    int score;   //for destroying one
+    int drop;    //DROP_* rule for what it may leave behind, or NO_DROP
+    int spawnWeight; //chance of being the next alien spawned, relative to the other kinds...
+    int spawnWeightPerLevel; //...plus this much per level
+};
+
+//Indexed by archetype.  Every kind scores 250: the original rules only meant to
+//give 1000 for a Snagglegon, but tested the attacker's tag, so they never did.
+constexpr AlienKind ALIEN_KINDS[] = {
+    { IID_SMALLGON,   5,  2.0,  250, NO_DROP,       60, 0  },
+    { IID_SMOREGON,   5,  2.0,  250, DROP_SUPPLIES, 20, 5  },
+    { IID_SNAGGLEGON, 10, 1.75, 250, DROP_LIFE,     5,  10 },
+};
+
+static_assert(sizeof(ALIEN_KINDS) / sizeof(ALIEN_KINDS[0]) == ARCH_SNAGGLEGON + 1, "one row per alien archetype");
+
+inline const AlienKind& alienKind(int archetype)
+{
+    return ALIEN_KINDS[archetype];
+}
+
+constexpr double alienHitPoints(int archetype, int level)
+{
+    return ALIEN_KINDS[archetype].hits * (1 + (level - 1) * .1);
+}
+
+constexpr int alienSpawnWeight(int archetype, int level)
+{
+    return ALIEN_KINDS[archetype].spawnWeight + ALIEN_KINDS[archetype].spawnWeightPerLevel * level;
+}
+
+//****** Player and goodies ******//
+
+const double PLAYER_MAX_HIT_POINTS = 50;
+const int PLAYER_MAX_CABBAGES = 30;
+
+struct GoodieKind
+{
+    int score; //for picking one up
+    double health; //hit points restored to the player
+    int lives;
+    int torpedoes;
+};
+
+//Indexed by archetype - ARCH_REPAIR
+constexpr GoodieKind GOODIE_KINDS[] = {
+    { 100, 10, 0, 0 }, //repair
+    { 100, 0,  1, 0 }, //extra life
+    { 100, 0,  0, 5 }, //torpedoes
+};
+
+static_assert(sizeof(GOODIE_KINDS) / sizeof(GOODIE_KINDS[0]) == ARCH_TORPEDO_GOODIE - ARCH_REPAIR + 1, "one row per goodie archetype");
+
+inline const GoodieKind& goodieKind(int archetype)
+{
+    return GOODIE_KINDS[archetype - ARCH_REPAIR];
+}
+
+#endif // GAMERULES_H_
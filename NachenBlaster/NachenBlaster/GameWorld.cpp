@@ -1,5 +1,4 @@
 #include "GameWorld.h"
-#include "GameController.h"
 #include <string>
 #include <cstdlib>
 using namespace std;
@@ -21,7 +20,7 @@ void GameWorld::playSound(int soundID)
 	m_controller->playSound(soundID);
 }
 
-void GameWorld::setGameStatText(string text)
+void GameWorld::setGameStatText(string_view text)
 {
 	m_controller->setGameStatText(text);
 }
@@ -2,11 +2,27 @@
 #define GAMEWORLD_H_
 
 #include "GameConstants.h"
+#include "GraphObject.h"
 #include <string>
+#include <string_view>
 
 const int START_PLAYER_LIVES = 3;
 
-class GameController;
+  // The services a GameWorld needs from whatever is driving it.  The windowed
+  // GameController is one such driver; HeadlessController is another.
+
+class WorldController
+{
+  public:
+	virtual ~WorldController()
+	{
+	}
+
+	virtual bool getLastKey(int& value) = 0;
+	virtual void playSound(int soundID) = 0;
+	virtual void setGameStatText(std::string_view text) = 0;
+	virtual void quitGame() = 0;
+};
 
 class GameWorld
 {
@@ -26,7 +42,7 @@ public:
 	virtual int move() = 0;
 	virtual void cleanUp() = 0;
 
-	void setGameStatText(std::string text);
+	void setGameStatText(std::string_view text);
 
 	bool getKey(int& value);
 	void playSound(int soundID);
@@ -72,8 +88,15 @@ public:
 	{
 		++m_level;
 	}
+
+	  // Steps the world back the given number of ticks, if it keeps a history.
+	  // Returns false if it can't.
+	virtual bool rewind(int /* ticks */)
+	{
+		return false;
+	}
    
-	void setController(GameController* controller)
+	void setController(WorldController* controller)
 	{
 		m_controller = controller;
 	}
@@ -82,13 +105,27 @@ public:
 	{
 		return m_assetDir;
 	}
+
+	  // For worlds restoring a saved state
+	void restoreProgress(unsigned int score, unsigned int lives, unsigned int level)
+	{
+		m_score = score;
+		m_lives = lives;
+		m_level = level;
+	}
+
+	GraphObjectRegistry& graphObjects()
+	{
+		return m_graphObjects;
+	}
 	
 private:
 	unsigned int	m_lives;
 	unsigned int	m_score;
 	unsigned int	m_level;
-	GameController* m_controller;
+	WorldController* m_controller;
 	std::string		m_assetDir;
+	GraphObjectRegistry m_graphObjects;
 };
 
 #endif // GAMEWORLD_H_
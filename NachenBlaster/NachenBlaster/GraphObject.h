@@ -2,45 +2,102 @@
 #define GRAPHOBJ_H_
 
 #include "GameConstants.h"
-#include <set>
+#include "Fixed.h"
+#include <vector>
 
 const int ANIMATION_POSITIONS_PER_TICK = 1;
 
 using Direction = int;
 
+class GraphObject;
+
+// Sprites of one image that a subsystem keeps in its own parallel arrays
+// (see StarField.h) rather than as a GraphObject each.  They never animate
+// or rotate, so the renderer can draw the whole batch in one call.
+struct SpriteBatch
+{
+    int imageID;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> size;
+};
+
+// Every live GraphObject, kept in one dense array per depth.  Adding is a
+// push_back and removing swaps the last object into the hole, so both are
+// O(1), and drawing walks contiguous memory.  Each GameWorld owns one, so
+// several worlds can exist in one process.
+// SpriteBatches registered at a depth are drawn before that depth's objects.
+class GraphObjectRegistry
+{
+public:
+    static const int NUM_DEPTHS = 4;
+    
+    void add(GraphObject* go);
+    void remove(GraphObject* go);
+    size_t size() const;
+    void addBatch(const SpriteBatch* batch, int depth);
+    void removeBatch(const SpriteBatch* batch);
+    
+    // plotBatch(imageID, x, y, size, count) draws a whole batch
+    template<typename Func, typename BatchFunc>
+    void drawAll(Func plotFunc, BatchFunc plotBatch);
+    
+    // Batches go through plotFunc one sprite at a time
+    template<typename Func>
+    void drawAll(Func plotFunc);
+    
+private:
+    std::vector<GraphObject*> m_objects[NUM_DEPTHS];
+    std::vector<const SpriteBatch*> m_batches[NUM_DEPTHS];
+};
+
 class GraphObject
 {
 protected:
-    GraphObject(int imageID, double startX, double startY, int dir = 0, double size = 1.0, int depth = 0)
-    : m_imageID(imageID), m_animationNumber(0), m_x(startX), m_y(startY),
-    m_destX(startX), m_destY(startY), m_direction(dir),
-    m_size(size <= 0 ? 1 : size), m_depth(depth)
+    GraphObject(GraphObjectRegistry& registry, int imageID, double startX, double startY, int dir = 0, double size = 1.0, int depth = 0)
+    : m_imageID(imageID), m_animationNumber(0), m_x(toFixed(startX)), m_y(toFixed(startY)),
+    m_destX(m_x), m_destY(m_y), m_direction(dir),
+    m_size(toFixed(size <= 0 ? 1 : size)),
+    m_depth(depth >= 0 && depth < GraphObjectRegistry::NUM_DEPTHS ? depth : 0),
+    m_registry(registry), m_slot(0)
     {
-        getGraphObjects(m_depth).insert(this);
+        m_registry.add(this);
     }
     
 public:
     virtual ~GraphObject()
     {
-        getGraphObjects(m_depth).erase(this);
+        m_registry.remove(this);
     }
     
     double getX() const
     {
         // If already moved but not yet animated, use new location anyway.
-        return m_destX;
+        return fromFixed(m_destX);
     }
     
     double getY() const
     {
         // If already moved but not yet animated, use new location anyway.
+        return fromFixed(m_destY);
+    }
+    
+    // Positions and sizes are kept in 16.16 fixed point (see Fixed.h);
+    // the double accessors convert exactly, and moveTo/setSize round.
+    Fixed getFixedX() const
+    {
+        return m_destX;
+    }
+    
+    Fixed getFixedY() const
+    {
         return m_destY;
     }
     
     virtual void moveTo(double x, double y)
     {
-        m_destX = x;
-        m_destY = y;
+        m_destX = toFixed(x);
+        m_destY = toFixed(y);
         m_animationNumber++;
     }
     
@@ -59,44 +116,44 @@ public:
     
     void setSize(double size)
     {
-        m_size = size;
+        m_size = toFixed(size);
     }
     
     double getSize() const
     {
-        return m_size;
+        return fromFixed(m_size);
     }
     
     double getRadius() const
     {
-        const int RADIUS_PER_UNIT = 8;
-        return RADIUS_PER_UNIT * m_size;
+        return fromFixed(getFixedRadius());
     }
     
-    template<typename Func>
-    static void drawAllObjects(Func plotFunc)
+    Fixed getFixedSize() const
     {
-        for (int depth = NUM_DEPTHS - 1; depth >= 0; depth--)
-        {
-            for (GraphObject* go : getGraphObjects(depth))
-            {
-                go->animate();
-                plotFunc(go->m_imageID, go->m_animationNumber, go->m_x, go->m_y, go->m_direction, go->m_size);
-            }
-        }
+        return m_size;
+    }
+    
+    Fixed getFixedRadius() const
+    {
+        const int RADIUS_PER_UNIT = 8;
+        return RADIUS_PER_UNIT * m_size;
     }
     
 private:
-    static const int NUM_DEPTHS = 4;
+    friend class GraphObjectRegistry;
+    
     int             m_imageID;
     unsigned int    m_animationNumber;
-    double          m_x;
-    double          m_y;
-    double          m_destX;
-    double          m_destY;
+    Fixed           m_x;
+    Fixed           m_y;
+    Fixed           m_destX;
+    Fixed           m_destY;
     int                m_direction;
-    double          m_size;
+    Fixed           m_size;
     int             m_depth;
+    GraphObjectRegistry& m_registry;
+    size_t          m_slot;  // index in m_registry's array for m_depth
     
     void animate()
     {
@@ -106,9 +163,9 @@ private:
         // moveALittle(m_y, m_destY);
     }
     
-    void moveALittle(double& from, double& to)
+    void moveALittle(Fixed& from, Fixed& to)
     {
-        static const double DISTANCE = 1.0/ANIMATION_POSITIONS_PER_TICK;
+        static const Fixed DISTANCE = FIXED_ONE/ANIMATION_POSITIONS_PER_TICK;
         if (to - from >= DISTANCE)
             from += DISTANCE;
         else if (from - to >= DISTANCE)
@@ -117,18 +174,77 @@ private:
             from = to;
     }
     
-    static std::set<GraphObject*>& getGraphObjects(int depth)
-    {
-        static std::set<GraphObject*> m_graphObjects[NUM_DEPTHS];
-        if (depth < NUM_DEPTHS)
-            return m_graphObjects[depth];
-        else
-            return m_graphObjects[0];         // empty;
-    }
-    
     // Prevent copying or assigning GraphObjects
     GraphObject(const GraphObject&) = delete;
     GraphObject& operator=(const GraphObject&) = delete;
 };
 
+inline void GraphObjectRegistry::add(GraphObject* go)
+{
+    std::vector<GraphObject*>& v = m_objects[go->m_depth];
+    go->m_slot = v.size();
+    v.push_back(go);
+}
+
+inline void GraphObjectRegistry::remove(GraphObject* go)
+{
+    std::vector<GraphObject*>& v = m_objects[go->m_depth];
+    GraphObject* last = v.back();
+    v[go->m_slot] = last;
+    last->m_slot = go->m_slot;
+    v.pop_back();
+}
+
+inline size_t GraphObjectRegistry::size() const
+{
+    size_t n = 0;
+    for (const std::vector<GraphObject*>& v : m_objects)
+        n += v.size();
+    return n;
+}
+
+inline void GraphObjectRegistry::addBatch(const SpriteBatch* batch, int depth)
+{
+    m_batches[depth >= 0 && depth < NUM_DEPTHS ? depth : 0].push_back(batch);
+}
+
+inline void GraphObjectRegistry::removeBatch(const SpriteBatch* batch)
+{
+    for (std::vector<const SpriteBatch*>& v : m_batches)
+    {
+        for (size_t k = 0; k < v.size(); k++)
+        {
+            if (v[k] == batch)
+            {
+                v.erase(v.begin() + k);
+                return;
+            }
+        }
+    }
+}
+
+template<typename Func, typename BatchFunc>
+void GraphObjectRegistry::drawAll(Func plotFunc, BatchFunc plotBatch)
+{
+    for (int depth = NUM_DEPTHS - 1; depth >= 0; depth--)
+    {
+        for (const SpriteBatch* b : m_batches[depth])
+            plotBatch(b->imageID, b->x.data(), b->y.data(), b->size.data(), b->x.size());
+        for (GraphObject* go : m_objects[depth])
+        {
+            go->animate();
+            plotFunc(go->m_imageID, go->m_animationNumber, fromFixed(go->m_x), fromFixed(go->m_y), go->m_direction, fromFixed(go->m_size));
+        }
+    }
+}
+
+template<typename Func>
+void GraphObjectRegistry::drawAll(Func plotFunc)
+{
+    drawAll(plotFunc, [&plotFunc](int imageID, const double* x, const double* y, const double* size, size_t count) {
+        for (size_t k = 0; k < count; k++)
+            plotFunc(imageID, 0, x[k], y[k], 0, size[k]);
+    });
+}
+
 #endif // GRAPHOBJ_H_
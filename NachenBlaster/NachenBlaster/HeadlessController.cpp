@@ -0,0 +1,61 @@
+#include "HeadlessController.h"
+#include "GameConstants.h"
+using namespace std;
+
+const int NO_KEY = 0;
+
+static int scriptKey(char c) //same key mapping as GameController::keyboardEvent
+{
+    switch (c)
+    {
+        case 'a': return KEY_PRESS_LEFT;
+        case 'd': return KEY_PRESS_RIGHT;
+        case 'w': return KEY_PRESS_UP;
+        case 's': return KEY_PRESS_DOWN;
+        case 't': return KEY_PRESS_TAB;
+        case ' ': return KEY_PRESS_SPACE;
+        default:  return NO_KEY;
+    }
+}
+
+HeadlessController::HeadlessController(string script)
+: m_pos(0), m_lastKeyHit(NO_KEY), m_quit(false), m_soundsPlayed(0)
+{
+    setScript(script);
+}
+
+void HeadlessController::setScript(string script)
+{
+    m_script = script;
+    m_pos = 0;
+    m_lastKeyHit = NO_KEY;
+}
+
+void HeadlessController::nextTick()
+{
+    if (m_script.empty())
+    {
+        m_lastKeyHit = NO_KEY;
+        return;
+    }
+    m_lastKeyHit = scriptKey(m_script[m_pos]);
+    m_pos = (m_pos + 1) % m_script.size();
+}
+
+bool HeadlessController::getLastKey(int& value)
+{
+    if (m_lastKeyHit != NO_KEY)
+    {
+        value = m_lastKeyHit;
+        m_lastKeyHit = NO_KEY;
+        return true;
+    }
+    return false;
+}
+
+void HeadlessController::playSound(int soundID) { m_soundsPlayed++; } //no audio device
+void HeadlessController::setGameStatText(string_view text) { m_gameStatText.assign(text.data(), text.size()); }
+void HeadlessController::quitGame() { m_quit = true; }
+bool HeadlessController::quitRequested() const { return m_quit; }
+const string& HeadlessController::getGameStatText() const { return m_gameStatText; }
+long HeadlessController::getSoundsPlayed() const { return m_soundsPlayed; }
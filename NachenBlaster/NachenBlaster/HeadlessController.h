@@ -0,0 +1,32 @@
+#ifndef HEADLESSCONTROLLER_H_
+#define HEADLESSCONTROLLER_H_
+
+#include "GameWorld.h"
+#include <string>
+
+//Drives a GameWorld without a window, a timer or sound.
+//Key input comes from a script: one character per tick, repeated when it runs out.
+//  a/d/w/s = left/right/up/down, ' ' = cabbage, t = torpedo, '.' = no key
+class HeadlessController : public WorldController
+{
+public:
+    HeadlessController(std::string script = "");
+    void setScript(std::string script);
+    void nextTick(); //advance the script by one tick
+    virtual bool getLastKey(int& value);
+    virtual void playSound(int soundID);
+    virtual void setGameStatText(std::string_view text);
+    virtual void quitGame();
+    bool quitRequested() const;
+    const std::string& getGameStatText() const;
+    long getSoundsPlayed() const;
+private:
+    std::string m_script;
+    size_t m_pos;
+    int m_lastKeyHit;
+    bool m_quit;
+    long m_soundsPlayed;
+    std::string m_gameStatText;
+};
+
+#endif // HEADLESSCONTROLLER_H_
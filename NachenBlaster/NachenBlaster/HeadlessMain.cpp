@@ -0,0 +1,350 @@
+#include "HeadlessController.h"
+#include "ReplayController.h"
+#include "ReplayReader.h"
+#include "StudentWorld.h"
+#include "GameConstants.h"
+#include "StressSettings.h"
+#include "TickProfiler.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+using namespace std;
+
+  // Runs the game with no window, no frame timer and no sound, as fast as the
+  // simulation allows.  Usage:
+  //   NachenBlasterHeadless [-ticks N] [-script KEYS] [-seed S] [-broadphase grid|sweep] [-threads T] [-record FILE] [-profile 1]
+  //                         [-rewindAt TICK] [-rewindTicks N]
+  //   NachenBlasterHeadless -replay FILE [-seek TICK] [-broadphase grid|sweep] [-threads T]
+  // Stress options (see StressSettings.h), any of which makes it a stress run:
+  //   [-aliensPerTick N] [-maxAliens N] [-fireOdds N] [-maxProjectiles N] [-invulnerable 1] [-endless 1]
+  // KEYS is one character per tick (see HeadlessController.h) and repeats.
+  // Game k of a run is seeded with S+k, so a run is reproducible from S,
+  // whatever the number of threads T.
+  // -profile prints where the last game's ticks went (needs an NB_PROFILE build).
+  // -record saves the first game as a replay and ends the run with it, then
+  // plays the replay back and fails unless it ends with the same score, level
+  // and lives.
+  // -rewindAt rewinds the first game N ticks (default 100) once it reaches
+  // TICK, as the rewind key would; with -record, that checks a rewound
+  // recording replays the game as it was finally played.
+  // -replay plays a recorded game to its end, starting from the keyframe
+  // nearest TICK and simulating only from there.
+  // A stress run also prints how long ticks took against how many actors
+  // they had, and, in an NB_PROFILE build, where that time went.
+
+const long DEFAULT_TICKS = 100000;
+const string DEFAULT_SCRIPT = " ....w ....s";
+
+  // Moves the world one tick and takes care of lives and levels like
+  // GameController does.  levelFinished(*world) runs each time the world
+  // advances a level.  When the game is over, gameOver(world) may point world
+  // at a new game and return true to carry on with it; otherwise step()
+  // returns false.
+template<typename LevelHook, typename GameOverHook>
+static bool step(StudentWorld*& world, LevelHook levelFinished, GameOverHook gameOver)
+{
+	int status = world->move();
+	if (status == GWSTATUS_PLAYER_DIED)
+	{
+		world->cleanUp();
+		if (world->isGameOver()  &&  !gameOver(world))
+			return false;
+		world->init();
+	}
+	else if (status == GWSTATUS_FINISHED_LEVEL)
+	{
+		world->advanceToNextLevel();
+		levelFinished(*world);
+		world->cleanUp();
+		world->init();
+	}
+	return true;
+}
+
+static bool step(StudentWorld*& world)
+{
+	return step(world, [](StudentWorld&) {}, [](StudentWorld*&) { return false; });
+}
+
+  // Tick times of a stress run, bucketed by the number of actors in the
+  // world: bucket b holds ticks that started with 2^(b-1) to 2^b - 1 actors
+class StressCurve
+{
+  public:
+	StressCurve()
+	 : m_profiled(false)
+	{
+	}
+
+	void add(size_t actors, double seconds, const StudentWorld& world)
+	{
+		size_t b = 0;
+		while ((actors >> b) != 0)
+			b++;
+		if (b >= m_buckets.size())
+			m_buckets.resize(b + 1);
+		Bucket& bucket = m_buckets[b];
+		bucket.ticks++;
+		bucket.seconds += seconds;
+		if (seconds > bucket.maxSeconds)
+			bucket.maxSeconds = seconds;
+		uint32_t ns[NUM_PROF_PHASES];
+		if (world.lastTickProfile(ns))
+		{
+			m_profiled = true;
+			for (int p = 0; p < NUM_PROF_PHASES; p++)
+				bucket.phaseNs[p] += ns[p];
+		}
+	}
+
+	void print(ostream& out) const
+	{
+		out << "    actors     ticks   mean us    max us";
+		if (m_profiled)
+			for (int p = 0; p < NUM_PROF_PHASES; p++)
+				out << setw(12) << profilePhaseName(p);
+		out << endl;
+		for (size_t b = 0; b < m_buckets.size(); b++)
+		{
+			const Bucket& bucket = m_buckets[b];
+			if (bucket.ticks == 0)
+				continue;
+			out << setw(10) << (b == 0 ? 0 : (1ul << (b - 1))) << setw(10) << bucket.ticks
+				<< setw(10) << (long)(1e6 * bucket.seconds / bucket.ticks) << setw(10) << (long)(1e6 * bucket.maxSeconds);
+			if (m_profiled)
+				for (int p = 0; p < NUM_PROF_PHASES; p++)
+					out << setw(12) << (long)(bucket.phaseNs[p] / 1000 / bucket.ticks);
+			out << endl;
+		}
+	}
+
+  private:
+	struct Bucket
+	{
+		long ticks = 0;
+		double seconds = 0;
+		double maxSeconds = 0;
+		double phaseNs[NUM_PROF_PHASES] = {};
+	};
+	vector<Bucket> m_buckets;
+	bool m_profiled;
+};
+
+  // How a game ended
+struct GameResult
+{
+	unsigned int score;
+	unsigned int level;
+	unsigned int lives;
+
+	bool operator==(const GameResult& other) const
+	{
+		return score == other.score  &&  level == other.level  &&  lives == other.lives;
+	}
+};
+
+static int playReplay(const string& path, unsigned long long seekTick, bool sweep, int threads, GameResult* result = nullptr)
+{
+	ReplayReader replay;
+	if (!replay.open(path))
+	{
+		cout << "Cannot read replay " << path << endl;
+		return 1;
+	}
+	HeadlessController output;
+	StudentWorld world("", replay.getSeed());
+	ReplayController input(replay, world, &output);
+	world.useSweepAndPrune(sweep);
+	world.setWorkerThreads(threads);
+	world.setController(&input);
+	world.init();
+
+	auto start = chrono::steady_clock::now();
+	unsigned long long keyframe = replay.seek(world, seekTick);
+	StudentWorld* played = &world;  // for step(), which never replaces it here
+	bool over = false;
+	while (!over  &&  world.getTick() < seekTick  &&  world.getTick() < replay.getLastTick())
+		over = !step(played);
+	double seekSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	unsigned long long from = world.getTick();
+	while (!over  &&  world.getTick() < replay.getLastTick())
+		over = !step(played);
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count() - seekSecs;
+	unsigned long long ticks = world.getTick() - from;
+
+	cout << "seed:        " << replay.getSeed() << endl;
+	cout << "keyframe:    " << keyframe << endl;
+	cout << "seek secs:   " << seekSecs << endl;
+	cout << "ticks:       " << from << " to " << world.getTick() << endl;
+	cout << "seconds:     " << secs << endl;
+	cout << "ticks/sec:   " << (secs > 0 ? ticks / secs : 0) << endl;
+	cout << "score:       " << world.getScore() << endl;
+	cout << "level:       " << world.getLevel() << endl;
+	cout << "lives:       " << world.getLives() << endl;
+	if (result != nullptr)
+		*result = GameResult{world.getScore(), world.getLevel(), world.getLives()};
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	long maxTicks = DEFAULT_TICKS;
+	string script = DEFAULT_SCRIPT;
+	unsigned long seed = 1;
+	bool sweep = false;
+	int threads = 1;
+	string recordPath;
+	string replayPath;
+	unsigned long long seekTick = 0;
+	bool profile = false;
+	unsigned long long rewindAt = 0;
+	int rewindTicks = 100;
+	StressSettings stress;
+	for (int k = 1; k + 1 < argc; k += 2)
+	{
+		string opt = argv[k];
+		if (opt == "-ticks")
+			maxTicks = atol(argv[k+1]);
+		else if (opt == "-script")
+			script = argv[k+1];
+		else if (opt == "-seed")
+			seed = strtoul(argv[k+1], nullptr, 10);
+		else if (opt == "-broadphase")
+			sweep = (string(argv[k+1]) == "sweep");
+		else if (opt == "-threads")
+			threads = atoi(argv[k+1]);
+		else if (opt == "-record")
+			recordPath = argv[k+1];
+		else if (opt == "-replay")
+			replayPath = argv[k+1];
+		else if (opt == "-profile")
+			profile = (atoi(argv[k+1]) != 0);
+		else if (opt == "-seek")
+			seekTick = strtoull(argv[k+1], nullptr, 10);
+		else if (opt == "-rewindAt")
+			rewindAt = strtoull(argv[k+1], nullptr, 10);
+		else if (opt == "-rewindTicks")
+			rewindTicks = atoi(argv[k+1]);
+		else if (opt == "-aliensPerTick")
+			stress.aliensPerTick = atoi(argv[k+1]);
+		else if (opt == "-maxAliens")
+			stress.maxAliens = atoi(argv[k+1]);
+		else if (opt == "-fireOdds")
+			stress.fireOdds = atoi(argv[k+1]);
+		else if (opt == "-maxProjectiles")
+			stress.maxProjectiles = atoi(argv[k+1]);
+		else if (opt == "-invulnerable")
+			stress.invulnerable = (atoi(argv[k+1]) != 0);
+		else if (opt == "-endless")
+			stress.endless = (atoi(argv[k+1]) != 0);
+		else
+		{
+			cout << "Unknown option " << opt << endl;
+			return 1;
+		}
+	}
+
+	if (!replayPath.empty())
+		return playReplay(replayPath, seekTick, sweep, threads);
+	if (stress.active()  &&  !recordPath.empty())
+	{
+		cout << "Stress runs can't be recorded: replays don't keep the stress settings" << endl;
+		return 1;
+	}
+
+	HeadlessController controller(script);
+	StudentWorld* gw = new StudentWorld("", seed);
+	gw->useSweepAndPrune(sweep);
+	gw->setWorkerThreads(threads);
+	gw->setStress(stress);
+	gw->setController(&controller);
+	if (!recordPath.empty()  &&  !gw->startRecording(recordPath))
+	{
+		cout << "Cannot record to " << recordPath << endl;
+		return 1;
+	}
+	gw->init();
+
+	long ticks = 0;
+	int games = 1;
+	unsigned int bestScore = 0;
+	unsigned int bestLevel = 1;
+	StressCurve curve;
+
+	auto levelFinished = [&](StudentWorld& world)
+	{
+		if (world.getLevel() > bestLevel)
+			bestLevel = world.getLevel();
+	};
+	auto gameOver = [&](StudentWorld*& world)
+	{
+		if (world->getScore() > bestScore)
+			bestScore = world->getScore();
+		if (!recordPath.empty())  // the recording is the first game
+			return false;
+		delete world;
+		world = new StudentWorld("", seed + games);
+		world->useSweepAndPrune(sweep);
+		world->setWorkerThreads(threads);
+		world->setStress(stress);
+		world->setController(&controller);
+		games++;
+		return true;
+	};
+
+	auto start = chrono::steady_clock::now();
+	bool playing = true;
+	while (playing  &&  ticks < maxTicks  &&  !controller.quitRequested())
+	{
+		controller.nextTick();
+		if (stress.active())
+		{
+			size_t actors = gw->getActors().size() + 1;  // and the player
+			auto tickStart = chrono::steady_clock::now();
+			playing = step(gw, levelFinished, gameOver);
+			curve.add(actors, chrono::duration<double>(chrono::steady_clock::now() - tickStart).count(), *gw);
+		}
+		else
+			playing = step(gw, levelFinished, gameOver);
+		ticks++;
+		if (rewindAt != 0  &&  games == 1  &&  gw->getTick() == rewindAt)
+		{
+			gw->rewind(rewindTicks);
+			rewindAt = 0;  // once: the game comes back through TICK
+		}
+	}
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (gw->getScore() > bestScore)
+		bestScore = gw->getScore();
+	if (profile)
+		gw->dumpProfile(cout);
+	if (stress.active())
+		curve.print(cout);
+	GameResult recorded = {gw->getScore(), gw->getLevel(), gw->getLives()};
+	delete gw;  // which also finishes the recording
+
+	cout << "ticks:       " << ticks << endl;
+	cout << "seconds:     " << secs << endl;
+	cout << "ticks/sec:   " << (secs > 0 ? ticks / secs : 0) << endl;
+	cout << "games:       " << games << endl;
+	cout << "best score:  " << bestScore << endl;
+	cout << "best level:  " << bestLevel << endl;
+
+	if (!recordPath.empty())
+	{
+		GameResult replayed;
+		if (playReplay(recordPath, 0, sweep, threads, &replayed) != 0)
+			return 1;
+		if (!(replayed == recorded))
+		{
+			cout << "Replay ends with score " << replayed.score << ", level " << replayed.level << ", " << replayed.lives
+				 << " lives; the game ended with score " << recorded.score << ", level " << recorded.level << ", " << recorded.lives << " lives" << endl;
+			return 1;
+		}
+		cout << "replay:      matches" << endl;
+	}
+	return 0;
+}
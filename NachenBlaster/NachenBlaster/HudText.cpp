@@ -0,0 +1,48 @@
+#include "HudText.h"
+#include <charconv>
+#include <cstring>
+using namespace std;
+
+HudText::HudText()
+: m_state(), m_valid(false), m_length(0)
+{}
+
+bool HudText::update(const HudState& state)
+{
+    if (m_valid && state.lives == m_state.lives && state.health == m_state.health && state.score == m_state.score
+        && state.level == m_state.level && state.cabbages == m_state.cabbages && state.torpedoes == m_state.torpedoes)
+        return false;
+    m_state = state;
+    m_valid = true;
+    format();
+    return true;
+}
+
+void HudText::invalidate() {m_valid = false;}
+
+string_view HudText::text() const {return string_view(m_text, m_length);}
+
+//Appends a label, then a number (and a suffix), to the line being built
+static char* put(char* p, char* end, const char* label, long long value, const char* suffix = "")
+{
+    const size_t n = strlen(label);
+    memcpy(p, label, n);
+    p = to_chars(p + n, end, value).ptr;
+    const size_t m = strlen(suffix);
+    memcpy(p, suffix, m);
+    return p + m;
+}
+
+//Same layout the old ostringstream/setw version produced: fields two spaces apart
+void HudText::format()
+{
+    char* p = m_text;
+    char* end = m_text + MAX_TEXT;
+    p = put(p, end, "Lives: ", m_state.lives);
+    p = put(p, end, "  Health: ", m_state.health, "%");
+    p = put(p, end, "  Score: ", m_state.score);
+    p = put(p, end, "  Level: ", m_state.level);
+    p = put(p, end, "  Cabbages: ", m_state.cabbages, "%");
+    p = put(p, end, "  Torpedoes: ", m_state.torpedoes);
+    m_length = p - m_text;
+}
@@ -0,0 +1,36 @@
+#ifndef HUDTEXT_H_
+#define HUDTEXT_H_
+
+#include <cstddef>
+#include <string_view>
+
+//What the status line shows
+struct HudState
+{
+    unsigned int lives;
+    int health;     //percent
+    unsigned int score;
+    unsigned int level;
+    int cabbages;   //percent
+    int torpedoes;
+};
+
+//The status line, kept formatted in a fixed buffer.  update() only reformats
+//when a field has changed, and formatting never touches the heap.
+class HudText
+{
+public:
+    HudText();
+    bool update(const HudState& state); //true if the text changed
+    void invalidate(); //the next update() reformats whatever it gets
+    std::string_view text() const;
+private:
+    static const size_t MAX_TEXT = 128; //fits every field at its longest
+    HudState m_state;
+    bool m_valid;
+    char m_text[MAX_TEXT];
+    size_t m_length;
+    void format();
+};
+
+#endif // HUDTEXT_H_
@@ -0,0 +1,94 @@
+#ifndef OBJECTPOOL_H_
+#define OBJECTPOOL_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+//Pool of T with an intrusive free list.  create() constructs in a free slot,
+//destroy() runs the destructor and returns the slot.  If every slot is taken,
+//create() chains on another slab as big as the pool so far and feeds its
+//slots into the free list, so a pool grows to the most objects alive at once
+//and after that never allocates again.
+template<typename T>
+class ObjectPool
+{
+public:
+    explicit ObjectPool(size_t capacity)
+    : m_free(nullptr), m_capacity(0), m_inUse(0)
+    {
+        addSlab(capacity > 0 ? capacity : 1);
+    }
+
+    ~ObjectPool()
+    {
+        for (Slot* slab : m_slabs) //objects must already have been destroyed
+            ::operator delete(slab);
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        if (m_free == nullptr)
+            addSlab(m_capacity); //doubles the pool
+        Slot* s = m_free;
+        m_free = s->next;
+        m_inUse++;
+        return new (s->storage) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* p)
+    {
+        Slot* s = reinterpret_cast<Slot*>(p);
+        p->~T();
+        s->next = m_free;
+        m_free = s;
+        m_inUse--;
+    }
+
+    size_t capacity() const //slots in every slab
+    {
+        return m_capacity;
+    }
+
+    size_t inUse() const
+    {
+        return m_inUse;
+    }
+
+    size_t slabCount() const //1 until the pool first fills
+    {
+        return m_slabs.size();
+    }
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<Slot*> m_slabs;
+    Slot* m_free;
+    size_t m_capacity;
+    size_t m_inUse;
+
+    void addSlab(size_t slots)
+    {
+        Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * slots));
+        m_slabs.push_back(slab);
+        for (size_t k = slots; k > 0; k--) //lowest slot first
+        {
+            slab[k-1].next = m_free;
+            m_free = &slab[k-1];
+        }
+        m_capacity += slots;
+    }
+
+    // Prevent copying or assigning ObjectPools
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+};
+
+#endif // OBJECTPOOL_H_
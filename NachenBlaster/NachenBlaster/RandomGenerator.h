@@ -0,0 +1,113 @@
+#ifndef RANDOMGENERATOR_H_
+#define RANDOMGENERATOR_H_
+
+#include <cstdint>
+
+//Small, fast, explicitly seeded generator (xoshiro256**, seeded through splitmix64).
+//Each StudentWorld owns one, so runs are reproducible from their seed and
+//several worlds can run side by side without sharing generator state.
+class RandomGenerator
+{
+public:
+    RandomGenerator(uint64_t seed = 0)
+    {
+        setSeed(seed);
+    }
+
+    void setSeed(uint64_t seed)
+    {
+        m_seed = seed;
+        for (int k = 0; k < 4; k++) //splitmix64 spreads the seed over the whole state
+        {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            m_state[k] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t getSeed() const
+    {
+        return m_seed;
+    }
+
+    //The whole generator state, for saving and restoring a world (see WorldSnapshot.h)
+    void getState(uint64_t state[4]) const
+    {
+        for (int k = 0; k < 4; k++)
+            state[k] = m_state[k];
+    }
+
+    void setState(const uint64_t state[4])
+    {
+        for (int k = 0; k < 4; k++)
+            m_state[k] = state[k];
+    }
+
+    uint64_t next()
+    {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    //Uniform int from min to max, inclusive.  Uses Lemire's multiply-and-shift
+    //reduction, so the common path has no division; the modulo only runs in
+    //the rare case that the draw lands in the biased region.
+    int randInt(int min, int max)
+    {
+        if (max < min)
+        {
+            int tmp = min;
+            min = max;
+            max = tmp;
+        }
+        const uint32_t range = (uint32_t)((int64_t)max - min + 1);
+        if (range == 0) //full 32-bit range
+            return (int)(uint32_t)(next() >> 32);
+        uint64_t m = (next() >> 32) * range;
+        uint32_t low = (uint32_t)m;
+        if (low < range)
+        {
+            const uint32_t threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                m = (next() >> 32) * range;
+                low = (uint32_t)m;
+            }
+        }
+        return (int)(min + (int64_t)(m >> 32));
+    }
+
+    //Fill out[0..count) with uniform ints from min to max, inclusive
+    void randInts(int* out, int count, int min, int max)
+    {
+        for (int k = 0; k < count; k++)
+            out[k] = randInt(min, max);
+    }
+
+    //Uniform double in [min, max)
+    double randDouble(double min, double max)
+    {
+        const double r = (next() >> 11) * (1.0 / 9007199254740992.0); //53 random bits
+        return min + r * (max - min);
+    }
+
+private:
+    uint64_t m_seed;
+    uint64_t m_state[4];
+
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif // RANDOMGENERATOR_H_
@@ -0,0 +1,28 @@
+#include "ReplayController.h"
+#include "ReplayReader.h"
+#include "StudentWorld.h"
+using namespace std;
+
+ReplayController::ReplayController(ReplayReader& replay, const StudentWorld& world, WorldController* output)
+: m_replay(replay), m_world(world), m_output(output)
+{}
+
+bool ReplayController::getLastKey(int& value) {return m_replay.keyAt(m_world.getTick(), value);}
+
+void ReplayController::playSound(int soundID)
+{
+    if (m_output != nullptr)
+        m_output->playSound(soundID);
+}
+
+void ReplayController::setGameStatText(string_view text)
+{
+    if (m_output != nullptr)
+        m_output->setGameStatText(text);
+}
+
+void ReplayController::quitGame()
+{
+    if (m_output != nullptr)
+        m_output->quitGame();
+}
@@ -0,0 +1,27 @@
+#ifndef REPLAYCONTROLLER_H_
+#define REPLAYCONTROLLER_H_
+
+#include "GameWorld.h"
+#include <string>
+
+class ReplayReader;
+class StudentWorld;
+
+//Feeds a world the keys recorded in a replay, by the world's own tick count
+//(so it keeps up after seeking or rewinding), and passes sound, status text
+//and quitting on to another controller, or drops them if there isn't one.
+class ReplayController : public WorldController
+{
+public:
+    ReplayController(ReplayReader& replay, const StudentWorld& world, WorldController* output = nullptr);
+    virtual bool getLastKey(int& value);
+    virtual void playSound(int soundID);
+    virtual void setGameStatText(std::string_view text);
+    virtual void quitGame();
+private:
+    ReplayReader& m_replay;
+    const StudentWorld& m_world;
+    WorldController* m_output;
+};
+
+#endif // REPLAYCONTROLLER_H_
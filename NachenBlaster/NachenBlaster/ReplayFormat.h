@@ -0,0 +1,68 @@
+#ifndef REPLAYFORMAT_H_
+#define REPLAYFORMAT_H_
+
+#include <cstdint>
+#include <vector>
+
+//Replay files: a header, then records in tick order, then an index of the
+//keyframes so a player can jump close to any tick without simulating from 0.
+//  header:  "NBRP", uint32 version, uint64 seed
+//  record:  type byte, then
+//             REPLAY_INPUT:    varint ticks since the previous record, varint key the world read that tick
+//             REPLAY_KEYFRAME: varint tick, varint length, that many bytes of world snapshot (WorldSnapshot.h)
+//             REPLAY_END:      varint ticks since the previous record: the last tick of the session
+//  index:   varint count, then for each keyframe uint64 tick, uint64 file offset of its record,
+//           then varint count, then for each cut uint64 start, uint64 end file offset
+//  trailer: uint64 file offset of the index, "NBIX"
+//Keyframes hold the state after their tick, and their tick is absolute, so
+//reading can start at any keyframe.
+//Rewinding while recording takes back the records after the tick rewound to:
+//those still in memory are dropped, and those already written are left in the
+//file as a cut, a byte range readers skip.  A keyframe at that tick follows.  Fixed-width fields are little-endian;
+//varints are LEB128.
+const char REPLAY_MAGIC[4] = {'N', 'B', 'R', 'P'};
+const char REPLAY_INDEX_MAGIC[4] = {'N', 'B', 'I', 'X'};
+const uint32_t REPLAY_VERSION = 5; //2: stars left the actor records; 3: so did explosions; 4: aliens draw random numbers by the block; 5: cuts
+const int REPLAY_INPUT = 1;
+const int REPLAY_KEYFRAME = 2;
+const int REPLAY_END = 3;
+const uint64_t REPLAY_KEYFRAME_TICKS = 500; //ticks between keyframes
+const int REPLAY_TRAILER_SIZE = 12;
+
+struct ReplayIndexEntry
+{
+    uint64_t tick;
+    uint64_t offset;
+};
+
+struct ReplayCut
+{
+    uint64_t start;
+    uint64_t end; //first offset after the cut
+};
+
+inline void putVarint(std::vector<unsigned char>& out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((unsigned char)v);
+}
+
+inline void putFixed(std::vector<unsigned char>& out, uint64_t v, int bytes)
+{
+    for (int k = 0; k < bytes; k++)
+        out.push_back((unsigned char)(v >> (8 * k)));
+}
+
+inline uint64_t getFixed(const unsigned char* p, int bytes)
+{
+    uint64_t v = 0;
+    for (int k = 0; k < bytes; k++)
+        v |= (uint64_t)p[k] << (8 * k);
+    return v;
+}
+
+#endif // REPLAYFORMAT_H_
@@ -0,0 +1,242 @@
+#include "ReplayReader.h"
+#include "StudentWorld.h"
+#include <cstring>
+using namespace std;
+
+static const uint64_t HEADER_SIZE = 16;
+
+ReplayReader::ReplayReader()
+: m_seed(0), m_lastTick(0), m_recordsEnd(0), m_fileSize(0), m_windowStart(0), m_readTick(0), m_readPos(0), m_ended(true)
+{}
+
+bool ReplayReader::open(const string& path)
+{
+    m_file.open(path, ios::binary);
+    if (!m_file)
+        return false;
+    unsigned char header[HEADER_SIZE];
+    if (!m_file.read(reinterpret_cast<char*>(header), HEADER_SIZE) || memcmp(header, REPLAY_MAGIC, 4) != 0
+        || getFixed(header + 4, 4) != REPLAY_VERSION)
+        return false;
+    m_seed = getFixed(header + 8, 8);
+    m_file.seekg(0, ios::end);
+    m_fileSize = (uint64_t)m_file.tellg();
+    if (!readIndex(m_fileSize))
+        scanIndex();
+    startWindow(nullptr);
+    return true;
+}
+
+uint64_t ReplayReader::getSeed() const {return m_seed;}
+uint64_t ReplayReader::getLastTick() const {return m_lastTick;}
+
+bool ReplayReader::readIndex(uint64_t fileSize) //from the trailer of a finished recording
+{
+    if (fileSize < HEADER_SIZE + REPLAY_TRAILER_SIZE)
+        return false;
+    unsigned char trailer[REPLAY_TRAILER_SIZE];
+    m_file.clear();
+    m_file.seekg(fileSize - REPLAY_TRAILER_SIZE);
+    if (!m_file.read(reinterpret_cast<char*>(trailer), REPLAY_TRAILER_SIZE) || memcmp(trailer + 8, REPLAY_INDEX_MAGIC, 4) != 0)
+        return false;
+    const uint64_t indexOffset = getFixed(trailer, 8);
+    m_file.seekg(indexOffset);
+    uint64_t count;
+    if (!readVarint(count))
+        return false;
+    m_index.resize(count);
+    for (ReplayIndexEntry& e : m_index)
+    {
+        unsigned char entry[16];
+        if (!m_file.read(reinterpret_cast<char*>(entry), 16))
+            return false;
+        e.tick = getFixed(entry, 8);
+        e.offset = getFixed(entry + 8, 8);
+    }
+    if (!readVarint(count))
+        return false;
+    m_cuts.resize(count);
+    for (ReplayCut& c : m_cuts)
+    {
+        unsigned char cut[16];
+        if (!m_file.read(reinterpret_cast<char*>(cut), 16))
+            return false;
+        c.start = getFixed(cut, 8);
+        c.end = getFixed(cut + 8, 8);
+    }
+    m_recordsEnd = indexOffset;
+    
+    //the END record's tick is the session length: read forward from the last keyframe to find it
+    startWindow(m_index.empty() ? nullptr : &m_index.back());
+    while (readRecord())
+        ;
+    m_lastTick = m_readTick;
+    return true;
+}
+
+void ReplayReader::scanIndex() //a recording that was cut off: walk every record
+{
+    m_index.clear();
+    m_cuts.clear();
+    m_recordsEnd = UINT64_MAX;
+    startWindow(nullptr);
+    vector<ReplayIndexEntry> records; //tick and offset of every record not taken back
+    for (;;)
+    {
+        const uint64_t at = m_readPos;
+        const uint64_t before = m_readTick;
+        const size_t keyframes = m_inputs.size(); //readRecord leaves inputs alone for keyframes
+        if (!readRecord())
+            break;
+        if (m_inputs.size() == keyframes && !m_ended)
+        {
+            if (m_readTick < before) //a rewind: cut what it took back, like the index would have
+            {
+                size_t keep = records.size();
+                while (keep > 0 && records[keep - 1].tick > m_readTick)
+                    keep--;
+                m_cuts.push_back(ReplayCut{records[keep].offset, at});
+                records.resize(keep);
+                while (!m_index.empty() && m_index.back().offset >= m_cuts.back().start)
+                    m_index.pop_back();
+                while (!m_inputs.empty() && m_inputs.back().tick > m_readTick)
+                    m_inputs.pop_back();
+            }
+            m_index.push_back(ReplayIndexEntry{m_readTick, at});
+        }
+        records.push_back(ReplayIndexEntry{m_readTick, at});
+    }
+    m_lastTick = m_readTick;
+}
+
+uint64_t ReplayReader::skipCuts(uint64_t pos) const
+{
+    bool moved = true;
+    while (moved) //a later rewind's cut can start before an earlier one ends
+    {
+        moved = false;
+        for (const ReplayCut& c : m_cuts)
+            if (pos >= c.start && pos < c.end)
+            {
+                pos = c.end;
+                moved = true;
+            }
+    }
+    return pos;
+}
+
+bool ReplayReader::keyAt(uint64_t tick, int& key)
+{
+    if (tick <= m_windowStart) //went back before what's parsed: start over from an earlier keyframe
+        startWindow(keyframeFor(tick, false));
+    while (m_readTick < tick && readRecord())
+        ;
+    size_t lo = 0, hi = m_inputs.size(); //binary search: inputs are in tick order
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        if (m_inputs[mid].tick < tick)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == m_inputs.size() || m_inputs[lo].tick != tick)
+        return false;
+    key = m_inputs[lo].key;
+    return true;
+}
+
+uint64_t ReplayReader::seek(StudentWorld& world, uint64_t tick)
+{
+    const ReplayIndexEntry* e = keyframeFor(tick, true);
+    if (e == nullptr && !m_index.empty()) //the recording started after tick
+        e = &m_index.front();
+    if (e == nullptr)
+        return 0;
+    m_file.clear();
+    m_file.seekg(e->offset);
+    uint64_t at, length;
+    if (m_file.get() != REPLAY_KEYFRAME || !readVarint(at) || !readVarint(length))
+        return 0;
+    vector<unsigned char> snapshot(length);
+    if (!m_file.read(reinterpret_cast<char*>(snapshot.data()), length))
+        return 0;
+    world.loadSnapshot(snapshot);
+    startWindow(e);
+    return e->tick;
+}
+
+//Last keyframe before tick (or at it, if inclusive), or nullptr
+const ReplayIndexEntry* ReplayReader::keyframeFor(uint64_t tick, bool inclusive) const
+{
+    const ReplayIndexEntry* found = nullptr;
+    for (const ReplayIndexEntry& e : m_index) //in tick order; a few per hour of play
+    {
+        if (e.tick > tick || (!inclusive && e.tick == tick))
+            break;
+        found = &e;
+    }
+    return found;
+}
+
+void ReplayReader::startWindow(const ReplayIndexEntry* from)
+{
+    m_inputs.clear();
+    m_windowStart = (from != nullptr) ? from->tick : 0;
+    m_readTick = m_windowStart;
+    m_readPos = (from != nullptr) ? from->offset : HEADER_SIZE;
+    m_ended = false;
+}
+
+bool ReplayReader::readVarint(uint64_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int c = m_file.get();
+        if (c == EOF)
+            return false;
+        v |= (uint64_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool ReplayReader::readRecord()
+{
+    m_readPos = skipCuts(m_readPos);
+    if (m_ended || m_readPos >= m_recordsEnd)
+        return false;
+    m_file.clear();
+    m_file.seekg(m_readPos);
+    const int type = m_file.get();
+    uint64_t tick, value;
+    switch (type)
+    {
+        case REPLAY_INPUT:
+            if (!readVarint(tick) || !readVarint(value))
+                return false;
+            m_readTick += tick;
+            m_inputs.push_back(Input{m_readTick, (int)(uint32_t)value});
+            break;
+        case REPLAY_KEYFRAME:
+            if (!readVarint(tick) || !readVarint(value))
+                return false;
+            if ((uint64_t)m_file.tellg() + value > m_fileSize) //cut off partway through
+                return false;
+            m_readTick = tick;
+            m_file.seekg(value, ios::cur); //the snapshot itself is only read by seek()
+            break;
+        case REPLAY_END:
+            if (!readVarint(tick))
+                return false;
+            m_readTick += tick;
+            m_ended = true;
+            break;
+        default: //cut off, or not a record
+            return false;
+    }
+    m_readPos = (uint64_t)m_file.tellg();
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef REPLAYREADER_H_
+#define REPLAYREADER_H_
+
+#include "ReplayFormat.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class StudentWorld;
+
+//Reads a replay file (ReplayFormat.h).  Inputs are parsed lazily, starting
+//from the nearest keyframe, so seeking deep into a long session reads only
+//the index and what follows the keyframe.
+class ReplayReader
+{
+public:
+    ReplayReader();
+    bool open(const std::string& path); //rebuilds the index by scanning if the recording was cut off
+    uint64_t getSeed() const;
+    uint64_t getLastTick() const;
+
+    //The key the world read on that tick, if it read one
+    bool keyAt(uint64_t tick, int& key);
+
+    //Loads the last keyframe at or before tick (or the first keyframe, if the
+    //recording started later) into world and returns its tick.  The world
+    //must have been init()ed.  Returns 0 and leaves world alone if there are
+    //no keyframes.
+    uint64_t seek(StudentWorld& world, uint64_t tick);
+
+private:
+    struct Input
+    {
+        uint64_t tick;
+        int key;
+    };
+
+    std::ifstream m_file;
+    uint64_t m_seed;
+    uint64_t m_lastTick;
+    uint64_t m_recordsEnd; //file offset just past the last record
+    uint64_t m_fileSize;
+    std::vector<ReplayIndexEntry> m_index;
+    std::vector<ReplayCut> m_cuts;
+    std::vector<Input> m_inputs; //parsed so far, for ticks after m_windowStart
+    uint64_t m_windowStart;
+    uint64_t m_readTick; //tick of the last record parsed
+    uint64_t m_readPos; //file offset of the next record
+    bool m_ended;
+
+    bool readIndex(uint64_t fileSize);
+    void scanIndex();
+    uint64_t skipCuts(uint64_t pos) const; //the first offset at or after pos that no cut covers
+    bool readVarint(uint64_t& v);
+    bool readRecord(); //parses the record at m_readPos
+    void startWindow(const ReplayIndexEntry* from); //from nullptr: the first record
+    const ReplayIndexEntry* keyframeFor(uint64_t tick, bool inclusive) const;
+};
+
+#endif // REPLAYREADER_H_
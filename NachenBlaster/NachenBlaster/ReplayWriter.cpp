@@ -0,0 +1,143 @@
+#include "ReplayWriter.h"
+using namespace std;
+
+ReplayWriter::ReplayWriter()
+: m_closing(false), m_offset(0), m_lastTick(0)
+{}
+
+ReplayWriter::~ReplayWriter()
+{
+    if (isOpen())
+        close(m_lastTick);
+}
+
+bool ReplayWriter::open(const string& path, uint64_t seed)
+{
+    if (isOpen())
+        return false;
+    m_file.open(path, ios::binary | ios::trunc);
+    if (!m_file)
+        return false;
+    m_pending.assign(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    putFixed(m_pending, REPLAY_VERSION, 4);
+    putFixed(m_pending, seed, 8);
+    m_offset = 0;
+    m_lastTick = 0;
+    m_index.clear();
+    m_records.clear();
+    m_cuts.clear();
+    m_closing = false;
+    m_thread = thread(&ReplayWriter::writeLoop, this);
+    return true;
+}
+
+bool ReplayWriter::isOpen() const {return m_thread.joinable();}
+
+void ReplayWriter::input(uint64_t tick, int key)
+{
+    m_records.push_back(ReplayIndexEntry{tick, m_offset + m_pending.size()});
+    m_pending.push_back(REPLAY_INPUT);
+    putVarint(m_pending, tick - m_lastTick);
+    putVarint(m_pending, (uint32_t)key);
+    m_lastTick = tick;
+    if (m_pending.size() >= HAND_OVER_BYTES)
+        handOver();
+}
+
+void ReplayWriter::keyframe(uint64_t tick, const vector<unsigned char>& snapshot)
+{
+    m_index.push_back(ReplayIndexEntry{tick, m_offset + m_pending.size()});
+    m_records.push_back(m_index.back());
+    m_pending.push_back(REPLAY_KEYFRAME);
+    putVarint(m_pending, tick);
+    putVarint(m_pending, snapshot.size());
+    m_pending.insert(m_pending.end(), snapshot.begin(), snapshot.end());
+    m_lastTick = tick;
+    handOver();
+}
+
+void ReplayWriter::rewind(uint64_t tick, const vector<unsigned char>& snapshot)
+{
+    size_t keep = m_records.size();
+    while (keep > 0 && m_records[keep - 1].tick > tick)
+        keep--;
+    if (keep < m_records.size())
+    {
+        const uint64_t start = m_records[keep].offset;
+        m_records.resize(keep);
+        while (!m_index.empty() && m_index.back().offset >= start)
+            m_index.pop_back();
+        if (start >= m_offset) //not handed over yet: forget it
+            m_pending.resize(start - m_offset);
+        else //maybe on the disk already: leave it there, for readers to skip
+            m_cuts.push_back(ReplayCut{start, m_offset + m_pending.size()});
+    }
+    keyframe(tick, snapshot); //also where a replay starts if the rewind went back past the first keyframe
+}
+
+void ReplayWriter::forgetBefore(uint64_t tick)
+{
+    while (!m_records.empty() && m_records.front().tick < tick)
+        m_records.pop_front();
+}
+
+void ReplayWriter::close(uint64_t lastTick)
+{
+    if (!isOpen())
+        return;
+    m_pending.push_back(REPLAY_END);
+    putVarint(m_pending, lastTick - m_lastTick);
+    const uint64_t indexOffset = m_offset + m_pending.size();
+    putVarint(m_pending, m_index.size());
+    for (const ReplayIndexEntry& e : m_index)
+    {
+        putFixed(m_pending, e.tick, 8);
+        putFixed(m_pending, e.offset, 8);
+    }
+    putVarint(m_pending, m_cuts.size());
+    for (const ReplayCut& c : m_cuts)
+    {
+        putFixed(m_pending, c.start, 8);
+        putFixed(m_pending, c.end, 8);
+    }
+    putFixed(m_pending, indexOffset, 8);
+    m_pending.insert(m_pending.end(), REPLAY_INDEX_MAGIC, REPLAY_INDEX_MAGIC + 4);
+    handOver();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_closing = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    m_file.close();
+}
+
+void ReplayWriter::handOver()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_handedOver.insert(m_handedOver.end(), m_pending.begin(), m_pending.end());
+    }
+    m_wake.notify_one();
+    m_offset += m_pending.size();
+    m_pending.clear();
+}
+
+void ReplayWriter::writeLoop()
+{
+    vector<unsigned char> batch;
+    for (;;)
+    {
+        bool closing;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_closing || !m_handedOver.empty(); });
+            batch.swap(m_handedOver);
+            closing = m_closing;
+        }
+        m_file.write(reinterpret_cast<const char*>(batch.data()), batch.size());
+        batch.clear();
+        if (closing)
+            return;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef REPLAYWRITER_H_
+#define REPLAYWRITER_H_
+
+#include "ReplayFormat.h"
+#include <condition_variable>
+#include <deque>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Records a session into a replay file (ReplayFormat.h).  Records are
+//encoded on the caller's thread and handed in batches to a writer thread,
+//so the game never waits on the disk.
+class ReplayWriter
+{
+public:
+    ReplayWriter();
+    ~ReplayWriter(); //closes, if still open
+    bool open(const std::string& path, uint64_t seed);
+    bool isOpen() const;
+    void input(uint64_t tick, int key);
+    void keyframe(uint64_t tick, const std::vector<unsigned char>& snapshot);
+    void rewind(uint64_t tick, const std::vector<unsigned char>& snapshot); //takes back the records after tick, then keyframes it
+    void forgetBefore(uint64_t tick); //no rewind() will go back before tick
+    void close(uint64_t lastTick); //ends the session, writes the index and waits for the disk
+
+private:
+    static const size_t HAND_OVER_BYTES = 64 << 10;
+
+    std::ofstream m_file;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<unsigned char> m_pending; //encoded on this thread, not handed over yet
+    std::vector<unsigned char> m_handedOver; //waiting for the writer thread
+    bool m_closing;
+    uint64_t m_offset; //file offset where m_pending starts
+    uint64_t m_lastTick; //tick of the latest record
+    std::vector<ReplayIndexEntry> m_index;
+    std::deque<ReplayIndexEntry> m_records; //tick and offset of every record rewind() may take back
+    std::vector<ReplayCut> m_cuts;
+
+    void handOver();
+    void writeLoop();
+
+    // Prevent copying or assigning ReplayWriters
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+};
+
+#endif // REPLAYWRITER_H_
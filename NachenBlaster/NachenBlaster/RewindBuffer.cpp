@@ -0,0 +1,179 @@
+#include "RewindBuffer.h"
+#include <cstring>
+#include <cstdint>
+using namespace std;
+
+//Encoded form: the snapshot XORed with its base (a missing base counts as
+//zeros), as 8-byte words in blocks of 64.  Each block is a mask with a bit
+//set for every nonzero word, then just those words.
+static const size_t BLOCK_WORDS = 64;
+static const vector<unsigned char> NO_BASE;
+
+RewindBuffer::RewindBuffer(size_t budget)
+: m_ring(budget), m_ringStart(0), m_ringUsed(0), m_first(0), m_count(0), m_sinceKeyframe(0)
+{}
+
+void RewindBuffer::clear()
+{
+    m_ringStart = 0;
+    m_ringUsed = 0;
+    m_first = 0;
+    m_count = 0;
+    m_sinceKeyframe = 0;
+    m_keyframe.clear();
+}
+
+size_t RewindBuffer::size() const {return m_count;}
+size_t RewindBuffer::bytesUsed() const {return m_ringUsed;}
+size_t RewindBuffer::budget() const {return m_ring.size();}
+
+RewindBuffer::Entry& RewindBuffer::entry(size_t k) {return m_entries[(m_first + k) % MAX_SNAPSHOTS];}
+
+void RewindBuffer::push(const vector<unsigned char>& snapshot)
+{
+    bool keyframe = (m_count == 0 || m_sinceKeyframe >= KEYFRAME_INTERVAL - 1);
+    encode(snapshot, keyframe ? NO_BASE : m_keyframe, m_encoded);
+    while (m_count > 0 && (m_count == MAX_SNAPSHOTS || m_ringUsed + m_encoded.size() > m_ring.size()))
+        dropOldest();
+    if (!keyframe && m_count == 0) //made room by dropping the keyframe this was encoded against
+    {
+        keyframe = true;
+        encode(snapshot, NO_BASE, m_encoded);
+    }
+    if (m_encoded.size() > m_ring.size()) //too big to keep at all
+        return;
+    store(keyframe, snapshot.size());
+    if (keyframe)
+    {
+        m_keyframe = snapshot;
+        m_sinceKeyframe = 0;
+    }
+    else
+        m_sinceKeyframe++;
+}
+
+bool RewindBuffer::rewind(size_t back, vector<unsigned char>& out)
+{
+    if (m_count == 0)
+        return false;
+    if (back >= m_count)
+        back = m_count - 1;
+    const size_t target = m_count - 1 - back;
+    size_t key = target;
+    while (!entry(key).keyframe) //the oldest entry is always a keyframe
+        key--;
+    load(entry(key), NO_BASE, m_keyframe);
+    if (target == key)
+        out = m_keyframe;
+    else
+        load(entry(target), m_keyframe, out);
+    
+    while (m_count > target + 1) //forget what came after
+    {
+        m_count--;
+        m_ringUsed -= entry(m_count).length;
+    }
+    m_sinceKeyframe = (int)(target - key);
+    return true;
+}
+
+void RewindBuffer::dropOldest() //and any deltas left without their keyframe
+{
+    do {
+        const Entry& e = entry(0);
+        m_ringStart = (e.offset + e.length) % m_ring.size();
+        m_ringUsed -= e.length;
+        m_first = (m_first + 1) % MAX_SNAPSHOTS;
+        m_count--;
+    } while (m_count > 0 && !entry(0).keyframe);
+    if (m_count == 0)
+        m_ringStart = 0;
+}
+
+void RewindBuffer::store(bool keyframe, size_t rawLength) //appends m_encoded
+{
+    const size_t cap = m_ring.size();
+    const size_t offset = (m_ringStart + m_ringUsed) % cap;
+    const size_t length = m_encoded.size();
+    const size_t first = (length < cap - offset) ? length : cap - offset; //bytes before the ring wraps
+    memcpy(&m_ring[offset], m_encoded.data(), first);
+    memcpy(&m_ring[0], m_encoded.data() + first, length - first);
+    m_entries[(m_first + m_count) % MAX_SNAPSHOTS] = Entry{offset, length, rawLength, keyframe};
+    m_count++;
+    m_ringUsed += length;
+}
+
+void RewindBuffer::load(const Entry& e, const vector<unsigned char>& base, vector<unsigned char>& out)
+{
+    const size_t cap = m_ring.size();
+    const size_t first = (e.length < cap - e.offset) ? e.length : cap - e.offset;
+    m_encoded.resize(e.length);
+    memcpy(m_encoded.data(), &m_ring[e.offset], first);
+    memcpy(m_encoded.data() + first, &m_ring[0], e.length - first);
+    
+    const size_t words = (e.rawLength + 7) / 8;
+    m_delta.assign(words, 0);
+    const unsigned char* p = m_encoded.data();
+    for (size_t b = 0; b < words; b += BLOCK_WORDS)
+    {
+        uint64_t mask;
+        memcpy(&mask, p, 8);
+        p += 8;
+        for (size_t k = b; mask != 0; k++, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                memcpy(&m_delta[k], p, 8);
+                p += 8;
+            }
+        }
+    }
+    out.resize(e.rawLength);
+    memcpy(out.data(), m_delta.data(), e.rawLength);
+    const size_t n = (base.size() < out.size()) ? base.size() : out.size();
+    for (size_t k = 0; k < n; k++)
+        out[k] ^= base[k];
+}
+
+void RewindBuffer::encode(const vector<unsigned char>& raw, const vector<unsigned char>& base, vector<unsigned char>& out)
+{
+    const size_t n = raw.size();
+    const size_t nb = (base.size() < n) ? base.size() : n;
+    const size_t words = (n + 7) / 8;
+    if (words == 0)
+    {
+        out.clear();
+        return;
+    }
+    m_delta.resize(words);
+    m_delta[words-1] = 0; //the bytes past n in a partial last word
+    memcpy(m_delta.data(), raw.data(), n);
+    for (size_t k = 0; k < nb / 8; k++)
+    {
+        uint64_t w;
+        memcpy(&w, &base[8*k], 8);
+        m_delta[k] ^= w;
+    }
+    unsigned char* d = reinterpret_cast<unsigned char*>(m_delta.data());
+    for (size_t k = nb & ~(size_t)7; k < nb; k++)
+        d[k] ^= base[k];
+    
+    out.resize(8 * ((words + BLOCK_WORDS - 1) / BLOCK_WORDS + words)); //room for every word
+    unsigned char* p = out.data();
+    for (size_t b = 0; b < words; b += BLOCK_WORDS)
+    {
+        const size_t end = (b + BLOCK_WORDS < words) ? b + BLOCK_WORDS : words;
+        unsigned char* maskAt = p;
+        p += 8;
+        uint64_t mask = 0;
+        for (size_t k = b; k < end; k++) //written either way, kept only if nonzero: no branches
+        {
+            const uint64_t w = m_delta[k];
+            memcpy(p, &w, 8);
+            p += (w != 0) * 8;
+            mask |= (uint64_t)(w != 0) << (k - b);
+        }
+        memcpy(maskAt, &mask, 8);
+    }
+    out.resize(p - out.data());
+}
@@ -0,0 +1,61 @@
+#ifndef REWINDBUFFER_H_
+#define REWINDBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Bounded history of world snapshots, newest last.
+//Every KEYFRAME_INTERVAL-th snapshot is a keyframe; the ones in between are
+//stored as their XOR against the latest keyframe, and everything is stored
+//with its all-zero 8-byte words left out, so what didn't change since the
+//keyframe costs a bit per word.  Storage is a ring of a fixed number of bytes allocated up front:
+//when it fills, the oldest keyframe and the snapshots that depend on it are
+//dropped together.
+class RewindBuffer
+{
+public:
+    static const size_t DEFAULT_BUDGET = 4 << 20; //bytes
+    static const size_t MAX_SNAPSHOTS = 1024;
+    static const int KEYFRAME_INTERVAL = 32;
+
+    explicit RewindBuffer(size_t budget = DEFAULT_BUDGET);
+    void clear();
+    void push(const std::vector<unsigned char>& snapshot);
+    size_t size() const; //snapshots held
+    size_t bytesUsed() const;
+    size_t budget() const; //bytes; a snapshot that doesn't encode into this many isn't kept
+
+    //Decodes the snapshot from `back` pushes before the newest one (0 = newest,
+    //clamped to the oldest held) into out, and forgets every snapshot after it.
+    //Returns false if the buffer is empty.
+    bool rewind(size_t back, std::vector<unsigned char>& out);
+
+private:
+    struct Entry
+    {
+        size_t offset; //into m_ring
+        size_t length; //encoded bytes
+        size_t rawLength; //decoded bytes
+        bool keyframe;
+    };
+
+    std::vector<unsigned char> m_ring;
+    size_t m_ringStart; //offset of the oldest entry's bytes
+    size_t m_ringUsed;
+    Entry m_entries[MAX_SNAPSHOTS]; //ring of entries, oldest at m_first
+    size_t m_first;
+    size_t m_count;
+    int m_sinceKeyframe; //snapshots pushed since the latest keyframe
+    std::vector<unsigned char> m_keyframe; //latest keyframe, decoded
+    std::vector<unsigned char> m_encoded; //scratch
+    std::vector<uint64_t> m_delta; //scratch
+
+    Entry& entry(size_t k); //k-th oldest
+    void dropOldest();
+    void store(bool keyframe, size_t rawLength);
+    void load(const Entry& e, const std::vector<unsigned char>& base, std::vector<unsigned char>& out);
+    void encode(const std::vector<unsigned char>& raw, const std::vector<unsigned char>& base, std::vector<unsigned char>& out);
+};
+
+#endif // REWINDBUFFER_H_
@@ -226,6 +226,48 @@ public:
         return true;
     }
     
+    // Plots count unrotated sprites of one image, frame 0, in a single
+    // glBegin/glEnd with the texture and blend state set once
+    bool plotSprites(int imageID, const double* x, const double* y, const double* size, size_t count)
+    {
+        if (count == 0)
+            return true;
+        auto it = m_imageMap.find(getSpriteID(imageID, 0));
+        if (it == m_imageMap.end())
+            return false;
+        
+        glPushAttrib(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glEnable(GL_TEXTURE_2D);
+        glDisable(GL_DEPTH_TEST);
+        glEnable (GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glBindTexture(GL_TEXTURE_2D, it->second);
+        glColor3f(1.0, 1.0, 1.0);
+        
+        glBegin(GL_QUADS);
+        for (size_t k = 0; k < count; k++)
+        {
+            double gx, gy, gz;
+            convertToGlutCoords(x[k], y[k], gx, gy, gz);
+            const double halfWidth = SPRITE_WIDTH_GL * size[k] / 2;
+            const double halfHeight = SPRITE_HEIGHT_GL * size[k] / 2;
+            glTexCoord2d(0, 0);
+            glVertex3f(static_cast<GLfloat>(gx - halfWidth), static_cast<GLfloat>(gy - halfHeight), static_cast<GLfloat>(gz));
+            glTexCoord2d(1, 0);
+            glVertex3f(static_cast<GLfloat>(gx + halfWidth), static_cast<GLfloat>(gy - halfHeight), static_cast<GLfloat>(gz));
+            glTexCoord2d(1, 1);
+            glVertex3f(static_cast<GLfloat>(gx + halfWidth), static_cast<GLfloat>(gy + halfHeight), static_cast<GLfloat>(gz));
+            glTexCoord2d(0, 1);
+            glVertex3f(static_cast<GLfloat>(gx - halfWidth), static_cast<GLfloat>(gy + halfHeight), static_cast<GLfloat>(gz));
+        }
+        glEnd();
+        
+        glDisable(GL_TEXTURE_2D);
+        glEnable(GL_DEPTH_TEST);
+        glPopAttrib();
+        return true;
+    }
+    
     ~SpriteManager()
     {
         for (auto it = m_imageMap.begin(); it != m_imageMap.end(); it++)
@@ -0,0 +1,72 @@
+#include "StarField.h"
+#include "GameConstants.h"
+using namespace std;
+
+StarField::StarField(GraphObjectRegistry& registry)
+: m_registry(registry)
+{
+    m_stars.imageID = IID_STAR;
+    m_registry.addBatch(&m_stars, DEPTH);
+}
+
+StarField::~StarField()
+{
+    m_registry.removeBatch(&m_stars);
+}
+
+void StarField::add(double x, double y, double size, double speed)
+{
+    m_stars.x.push_back(x);
+    m_stars.y.push_back(y);
+    m_stars.size.push_back(size);
+    m_speed.push_back(speed);
+}
+
+void StarField::update()
+{
+    const size_t n = m_stars.x.size();
+    double* x = m_stars.x.data();
+    const double* speed = m_speed.data();
+    bool anyGone = false;
+    for (size_t k = 0; k < n; k++) //no branches or calls, so this vectorizes
+    {
+        x[k] -= speed[k];
+        anyGone |= (x[k] < 0);
+    }
+    if (!anyGone)
+        return;
+
+    size_t k = 0;
+    size_t live = n;
+    while (k < live) //a star that left the screen gets the last star's slot
+    {
+        if (x[k] >= 0)
+        {
+            k++;
+            continue;
+        }
+        live--;
+        m_stars.x[k] = m_stars.x[live];
+        m_stars.y[k] = m_stars.y[live];
+        m_stars.size[k] = m_stars.size[live];
+        m_speed[k] = m_speed[live];
+    }
+    m_stars.x.resize(live);
+    m_stars.y.resize(live);
+    m_stars.size.resize(live);
+    m_speed.resize(live);
+}
+
+void StarField::clear()
+{
+    m_stars.x.clear();
+    m_stars.y.clear();
+    m_stars.size.clear();
+    m_speed.clear();
+}
+
+size_t StarField::size() const {return m_stars.x.size();}
+double StarField::getX(size_t k) const {return m_stars.x[k];}
+double StarField::getY(size_t k) const {return m_stars.y[k];}
+double StarField::getSize(size_t k) const {return m_stars.size[k];}
+double StarField::getSpeed(size_t k) const {return m_speed[k];}
@@ -0,0 +1,36 @@
+#ifndef STARFIELD_H_
+#define STARFIELD_H_
+
+#include "GraphObject.h"
+#include <cstddef>
+#include <vector>
+
+//The background stars, kept in parallel arrays instead of as actors.  They
+//only drift left, so a tick is one loop over the arrays; a star that leaves
+//the screen is dropped by moving the last star into its slot, so the arrays
+//stay dense and their storage is reused by later stars.  The arrays are a
+//SpriteBatch in the world's registry, so the renderer draws them in one go.
+class StarField
+{
+public:
+    static const int DEPTH = 3; //behind everything else
+
+    StarField(GraphObjectRegistry& registry);
+    ~StarField();
+    void add(double x, double y, double size, double speed = 1); //speed in pixels per tick
+    void update();
+    void clear(); //keeps capacity
+    size_t size() const;
+    double getX(size_t k) const;
+    double getY(size_t k) const;
+    double getSize(size_t k) const;
+    double getSpeed(size_t k) const;
+private:
+    GraphObjectRegistry& m_registry;
+    SpriteBatch m_stars;
+    std::vector<double> m_speed;
+    StarField(const StarField&) = delete;
+    StarField& operator=(const StarField&) = delete;
+};
+
+#endif // STARFIELD_H_
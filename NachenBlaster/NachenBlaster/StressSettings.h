@@ -0,0 +1,26 @@
+#ifndef STRESSSETTINGS_H_
+#define STRESSSETTINGS_H_
+
+//Raised limits for stress runs (see StudentWorld::setStress).  Every field
+//left at 0 or false keeps the normal rule, so a default StressSettings is the
+//normal game.
+struct StressSettings
+{
+    int aliensPerTick;  //aliens that may spawn each tick; 0 = one
+    int maxAliens;      //aliens on screen at once; 0 = the level's usual 4 + level/2
+    int fireOdds;       //each alien fires one tick in fireOdds, in the line of fire or not; 0 = the level's odds, only in line
+    int maxProjectiles; //aliens stop firing while this many projectiles are on screen; 0 = no cap
+    bool invulnerable;  //the player takes no damage
+    bool endless;       //levels never end
+
+    StressSettings()
+    : aliensPerTick(0), maxAliens(0), fireOdds(0), maxProjectiles(0), invulnerable(false), endless(false)
+    {}
+
+    bool active() const
+    {
+        return aliensPerTick > 0 || maxAliens > 0 || fireOdds > 0 || maxProjectiles > 0 || invulnerable || endless;
+    }
+};
+
+#endif // STRESSSETTINGS_H_
@@ -1,10 +1,12 @@
 #include "StudentWorld.h"
 #include "GameConstants.h"
 #include "Actor.h"
+#include "CollisionKernel.h"
+#include "WorldSnapshot.h"
+#include "GameRules.h"
 #include <math.h>
 #include <random>
-#include <sstream>
-#include <iomanip>
+#include <cstring>
 using namespace std;
 
 GameWorld* createStudentWorld(string assetDir)
@@ -12,215 +14,664 @@ GameWorld* createStudentWorld(string assetDir)
 	return new StudentWorld(assetDir);
 }
 
-double randDouble (double min, double max) //generate random double
-{
-    double r = (double)rand() / (double)RAND_MAX;
-    return min + r * (max - min);
-}
-
+//Unseeded worlds (the interactive game) pick a nondeterministic seed
 StudentWorld::StudentWorld(string assetDir)
-: GameWorld(assetDir), m_aliensDestroyed(0), m_currAliens(0), m_nb(nullptr)
+: StudentWorld(assetDir, random_device()())
+{}
+
+StudentWorld::StudentWorld(string assetDir, unsigned long seed)
+: GameWorld(assetDir), m_stars(graphObjects()), m_explosions(graphObjects(), IID_EXPLOSION), m_useSweep(false), m_nb(nullptr), m_aliensDestroyed(0), m_rng(seed), m_workers(nullptr),
+  m_tick(0), m_nextSpawnSeq(0), m_recorder(nullptr), m_lastKeyframe(0), m_keyframeDue(false)
 {}
 
 StudentWorld::~StudentWorld()
 {
+    stopRecording();
     cleanUp();
+    delete m_workers;
+}
+
+void StudentWorld::setWorkerThreads(int threads)
+{
+    delete m_workers;
+    m_workers = (threads > 1) ? new WorkerPool(threads) : nullptr;
 }
 
 
 int StudentWorld::init()
 {
-    m_currAliens = 0;
     m_aliensDestroyed = 0;
+    m_hud.invalidate(); //the controller may have been showing something else
     //initialize stars: can use setSize here too 
+    int starX[30];
+    int starY[30];
+    m_rng.randInts(starX, 30, 0, VIEW_WIDTH-1);
+    m_rng.randInts(starY, 30, 0, VIEW_HEIGHT-1);
     for (int k = 0; k < 30; k++)
-        m_actors.push_back(new Star((double)randInt(0, VIEW_WIDTH-1),(double)randInt(0, VIEW_HEIGHT-1)));
+        addStar(starX[k], starY[k]);
     
     //initialize player
     m_nb = new NachenBlaster(this);
+    m_nb->setHandle(m_handles.add(m_nb));
     
+    captureSnapshot();
     return GWSTATUS_CONTINUE_GAME;
 }
 
+#ifdef NB_PROFILE
+//Which profiler phase each archetype's updates are charged to
+static const int PROFILE_PHASE_OF[NUM_ARCHETYPES] = {
+    PROF_SMALLGONS, PROF_SMOREGONS, PROF_SNAGGLEGONS,
+    PROF_PROJECTILES, PROF_PROJECTILES, PROF_PROJECTILES,
+    PROF_GOODIES, PROF_GOODIES, PROF_GOODIES
+};
+#endif
+
 int StudentWorld::move()
 {
-    //go through NachenBlaster's doSomething
-    m_nb->doSomething();
-    if (!m_nb->isAlive())
+    //go through NachenBlaster's doSomething, let the aliens plan their moves, move the stars,
+    //then run all the other actors, one archetype at a time, and animate the explosions.
+    //Actors only change themselves here; everything else they do is queued in m_commands
+    PROFILE_BEGIN_TICK(m_profiler);
+    m_tick++;
+    m_nb->NachenBlaster::doSomething();
+    PROFILE_LAP(m_profiler, PROF_PLAYER);
+    planActors();
+    PROFILE_LAP(m_profiler, PROF_PLAN);
+    m_stars.update();
+    PROFILE_LAP(m_profiler, PROF_STARS);
+    updateGroups(std::make_index_sequence<NUM_ARCHETYPES>());
+    m_explosions.update();
+    PROFILE_LAP(m_profiler, PROF_EXPLOSIONS);
+    
+    //then apply the queued damage, spawns, score and sounds, and check the outcome once
+    applyCommands();
+    PROFILE_LAP(m_profiler, PROF_COMMANDS);
+    if (!m_nb->isAlive()) {
+        PROFILE_END_TICK(m_profiler);
         return GWSTATUS_PLAYER_DIED;
-    if (completedLevel())
+    }
+    if (completedLevel()) {
+        playSound(SOUND_FINISHED_LEVEL);
+        PROFILE_END_TICK(m_profiler);
         return GWSTATUS_FINISHED_LEVEL;
-    
-    list<Actor*>::iterator itr;
-    itr = m_actors.begin();
-    while (itr != m_actors.end()) //go through doSomething for all the other actors
-    {
-        Actor* ap = *itr;
-        ap->doSomething();
-        if (!m_nb->isAlive())
-            return GWSTATUS_PLAYER_DIED;
-        if (completedLevel()) {
-            playSound(SOUND_FINISHED_LEVEL);
-            return GWSTATUS_FINISHED_LEVEL;
-        }
-        itr++;
     }
     removeDeadGameObjects();
+    PROFILE_LAP(m_profiler, PROF_REMOVE_DEAD);
     updateDisplayText();
+    PROFILE_LAP(m_profiler, PROF_DISPLAY_TEXT);
     
     //Add a new star, potentially
     if (randInt(0, 14) < 1) //range 0 to 14
-        m_actors.push_back(new Star(VIEW_WIDTH-1,randDouble(0, VIEW_HEIGHT-1)));
+        addStar(VIEW_WIDTH-1, randDouble(0, VIEW_HEIGHT-1));
+    PROFILE_LAP(m_profiler, PROF_SPAWN_STAR);
     
-    //Add new alien
-    if (canAddAlien())
+    //Add new alien (more than one a tick in stress runs)
+    const int spawns = (m_stress.aliensPerTick > 0) ? m_stress.aliensPerTick : 1;
+    for (int k = 0; k < spawns && canAddAlien(); k++)
         addSomeAlien();
+    PROFILE_LAP(m_profiler, PROF_SPAWN_ALIEN);
     
+    captureSnapshot();
+    PROFILE_LAP(m_profiler, PROF_SNAPSHOT);
+    PROFILE_END_TICK(m_profiler);
     return GWSTATUS_CONTINUE_GAME;
 }
 
+//Every actor in a group has its archetype's exact type (ActorStore.h), so each group's
+//loop calls that type's doSomething() directly, with no virtual call per actor
+template<int archetype>
+void StudentWorld::updateGroup()
+{
+    typedef ArchetypeType<archetype> T;
+    ActorStore::Group& g = m_actors.group(archetype);
+    for (size_t k = 0; k < g.size(); k++)
+        static_cast<T*>(g.actor[k])->T::doSomething();
+    PROFILE_LAP(m_profiler, PROFILE_PHASE_OF[archetype]);
+}
+
+template<size_t... archetypes>
+void StudentWorld::updateGroups(std::index_sequence<archetypes...>) //in archetype order
+{
+    (updateGroup<archetypes>(), ...);
+}
+
+//A block of plans only reads its own aliens' slots and the snapshot in tick, so the order (and
+//the thread) blocks are planned in doesn't matter: a tick comes out the same for any number of threads
+void StudentWorld::planActors()
+{
+    const TickInfo tick = makeTickInfo(m_nb->getFixedX(), m_nb->getFixedY(), getLevel(), m_stress.fireOdds, m_rng.next());
+    for (int arch = ARCH_SMALLGON; arch <= ARCH_SNAGGLEGON; arch++) //only aliens have anything to plan
+    {
+        ActorStore::Group& g = m_actors.group(arch);
+        if (m_workers != nullptr && g.size() >= MIN_PARALLEL_PLANS)
+            m_workers->run(alienBlocks(g.size()), [arch, &g, &tick](size_t begin, size_t end) {
+                planAliens(arch, g, begin, end, tick);
+            });
+        else
+            planAliens(arch, g, 0, alienBlocks(g.size()), tick);
+    }
+}
+
 bool StudentWorld::canAddAlien() const //checks if alien can be added
 {
+    if (m_stress.maxAliens > 0)
+        return currentAliens() < m_stress.maxAliens;
     int total =  6 + (4 * getLevel());
     int remaining = total - m_aliensDestroyed;
     double max = 4 + (.5 * getLevel());
     double min = (remaining < max - 1) ? remaining : max - 1;
-    return (m_currAliens < min);
+    return (currentAliens() < min);
 }
 
-void StudentWorld::addSomeAlien()
+int StudentWorld::currentAliens() const //aliens on screen, including any killed this tick
 {
-    int s1 = 60;
-    int s2 = 20 + getLevel() * 5;
-    int s3 = 5 + getLevel() * 10;
-    int s = s1 + s2 + s3;
-    int r = randInt(0, s-1);
-    if (r < s1) //s1/s chance
-        m_actors.push_back(new Smallgon(VIEW_WIDTH-1,randDouble(0, VIEW_HEIGHT-1), getLevel(), this));
-    else if (r >= s1 && r < s1+s2) //s2/s chance
-        m_actors.push_back(new Smoregon(VIEW_WIDTH-1,randDouble(0, VIEW_HEIGHT-1), getLevel(), this));
-    else if (r < s) //s3/s chance
-        m_actors.push_back(new Snagglegon(VIEW_WIDTH-1,randDouble(0, VIEW_HEIGHT-1), getLevel(), this));
-    m_currAliens++;
+    return (int)(m_actors.group(ARCH_SMALLGON).size() + m_actors.group(ARCH_SMOREGON).size() + m_actors.group(ARCH_SNAGGLEGON).size());
 }
 
-void StudentWorld::cleanUp()
+int StudentWorld::currentProjectiles() const
 {
-    list<Actor*>::iterator itr;
-    itr = m_actors.begin();
-    while (itr != m_actors.end())
+    return (int)(m_actors.group(ARCH_CABBAGE).size() + m_actors.group(ARCH_TURNIP).size() + m_actors.group(ARCH_TORPEDO).size());
+}
+
+void StudentWorld::addSomeAlien() //each kind's chance is its spawn weight over the total (GameRules.h)
+{
+    int total = 0;
+    for (int arch = ARCH_SMALLGON; arch <= ARCH_SNAGGLEGON; arch++)
+        total += alienSpawnWeight(arch, getLevel());
+    int r = randInt(0, total-1);
+    int arch = ARCH_SMALLGON;
+    while (r >= alienSpawnWeight(arch, getLevel()))
     {
-        delete *itr;
-        itr = m_actors.erase(itr);
+        r -= alienSpawnWeight(arch, getLevel());
+        arch++;
     }
+    ActorState s = {};
+    s.x = VIEW_WIDTH-1;
+    s.y = randDouble(0, VIEW_HEIGHT-1);
+    s.archetype = arch;
+    addActor(createActor(s));
+}
+
+void StudentWorld::addActor(Actor* a)
+{
+    a->setSpawnSeq(m_nextSpawnSeq++);
+    trackActor(a);
+}
+
+Actor* StudentWorld::spawnActor(int archetype, double x, double y)
+{
+    ActorState s = {};
+    s.x = x;
+    s.y = y;
+    s.archetype = archetype;
+    s.tag = PLAYER_TORPEDO;
+    Actor* a = createActor(s);
+    addActor(a);
+    return a;
+}
+
+void StudentWorld::addStar(double x, double y)
+{
+    m_stars.add(x, y, randDouble(.05, .5));
+}
+
+void StudentWorld::trackActor(Actor* a) //file a in the store and the broadphase, and give it a handle
+{
+    a->setHandle(m_handles.add(a));
+    m_actors.add(a);
+    if (a->getHitMask() == 0) //actors nothing can hit never enter collision queries
+        return;
+    if (m_useSweep)
+        m_sweep.insert(a);
+    else
+        m_grid.insert(a);
+}
+
+void StudentWorld::cleanUp()
+{
+    removeAllActors();
+    m_history.clear(); //no rewinding into a previous life
+}
+
+void StudentWorld::removeAllActors()
+{
+    m_grid.clear();
+    m_sweep.clear();
+    m_actors.clear([this](Actor* ap) {
+        m_handles.remove(ap->getHandle());
+        m_pools.destroy(ap);
+    });
+    m_stars.clear();
+    m_explosions.clear();
+    m_commands.clear();
     if (m_nb != nullptr) //delete NachenBlaster
     {
+        m_handles.remove(m_nb->getHandle());
         delete m_nb;
         m_nb = nullptr;
     }
 }
 
-void StudentWorld::removeDeadGameObjects()
+unsigned long long StudentWorld::getTick() const {return m_tick;}
+
+//Snapshots are a WorldState then every actor's ActorState (WorldSnapshot.h)
+size_t StudentWorld::snapshotSize() const
 {
-    list<Actor*>::iterator itr;
-    itr = m_actors.begin();
-    while (itr != m_actors.end())
+    return sizeof(WorldState) + m_actors.size() * sizeof(ActorState) + m_stars.size() * sizeof(StarState)
+        + m_explosions.size() * sizeof(ParticleState);
+}
+
+void StudentWorld::saveSnapshot(vector<unsigned char>& out) const
+{
+    const size_t n = m_actors.size();
+    const size_t stars = m_stars.size();
+    const size_t particles = m_explosions.size();
+    out.resize(snapshotSize());
+    WorldState w = {}; //zeroes unused fields, so they encode to nothing
+    m_rng.getState(w.rng);
+    w.tick = m_tick;
+    w.nextSpawnSeq = m_nextSpawnSeq;
+    w.score = getScore();
+    w.lives = getLives();
+    w.level = getLevel();
+    w.aliensDestroyed = m_aliensDestroyed;
+    w.actorCount = (uint32_t)n;
+    w.starCount = (uint32_t)stars;
+    w.particleCount = (uint32_t)particles;
+    m_nb->saveState(w.player);
+    memcpy(out.data(), &w, sizeof(w));
+    
+    unsigned char* p = out.data() + sizeof(w);
+    for (int arch = 0; arch < NUM_ARCHETYPES; arch++)
     {
-        Actor* ap = *itr;
-        if (!ap->isAlive())
+        const ActorStore::Group& g = m_actors.group(arch);
+        for (size_t k = 0; k < g.size(); k++)
         {
-            if (ap->isAlien(ap->getTag())) //if a dead alien is removed, decrease current num of aliens
-                m_currAliens--;
-            delete *itr;
-            itr = m_actors.erase(itr);
-            continue;
+            ActorState a = {};
+            g.actor[k]->saveState(a);
+            memcpy(p, &a, sizeof(a));
+            p += sizeof(a);
         }
-        itr++;
     }
+    for (size_t k = 0; k < stars; k++)
+    {
+        StarState s = {m_stars.getX(k), m_stars.getY(k), m_stars.getSize(k), m_stars.getSpeed(k)};
+        memcpy(p, &s, sizeof(s));
+        p += sizeof(s);
+    }
+    for (size_t k = 0; k < particles; k++)
+    {
+        const Particle pt = m_explosions.get(k);
+        ParticleState s = {pt.x, pt.y, pt.vx, pt.vy, pt.size, pt.growth, pt.life, 0};
+        memcpy(p, &s, sizeof(s));
+        p += sizeof(s);
+    }
+}
+
+void StudentWorld::captureSnapshot() //after every tick: into the rewind history, and the recording now and then
+{
+    //Stress runs don't rewind, and a world bigger than the whole history would
+    //only be serialized to be thrown away, so decide before serializing
+    const bool history = !m_stress.active() && snapshotSize() <= m_history.budget();
+    const bool keyframe = m_recorder != nullptr && (m_keyframeDue || m_tick - m_lastKeyframe >= REPLAY_KEYFRAME_TICKS);
+    if (!history && m_history.size() > 0)
+        m_history.clear(); //rewinding mustn't skip over the ticks left out
+    if (history || keyframe)
+        saveSnapshot(m_snapshot);
+    if (history)
+        m_history.push(m_snapshot);
+    if (keyframe)
+    {
+        m_recorder->keyframe(m_tick, m_snapshot);
+        m_lastKeyframe = m_tick;
+        m_keyframeDue = false;
+    }
+    if (m_recorder != nullptr) //the history holds one snapshot a tick, up to now: nothing older can be rewound to
+        m_recorder->forgetBefore(m_tick + 1 - m_history.size());
+}
+
+void StudentWorld::loadSnapshot(const vector<unsigned char>& in)
+{
+    applySnapshot(in);
+    m_history.clear();
+    m_history.push(in);
+}
+
+bool StudentWorld::rewind(int ticks)
+{
+    if (m_nb == nullptr || ticks < 0 || !m_history.rewind(ticks, m_snapshot))
+        return false;
+    applySnapshot(m_snapshot);
+    if (m_recorder != nullptr) //the recording goes back with it, so it replays what's played from here
+    {
+        m_recorder->rewind(m_tick, m_snapshot);
+        m_lastKeyframe = m_tick;
+    }
+    return true;
+}
+
+void StudentWorld::applySnapshot(const vector<unsigned char>& in)
+{
+    WorldState w;
+    memcpy(&w, in.data(), sizeof(w));
+    removeAllActors();
+    m_nb = new NachenBlaster(this);
+    m_nb->setHandle(m_handles.add(m_nb));
+    m_nb->loadState(w.player);
+    const unsigned char* p = in.data() + sizeof(w);
+    for (uint32_t k = 0; k < w.actorCount; k++, p += sizeof(ActorState))
+    {
+        ActorState a;
+        memcpy(&a, p, sizeof(a));
+        Actor* ap = createActor(a);
+        ap->loadState(a); //including its spawn sequence number, so collision ties break as before
+        trackActor(ap);
+    }
+    for (uint32_t k = 0; k < w.starCount; k++, p += sizeof(StarState))
+    {
+        StarState s;
+        memcpy(&s, p, sizeof(s));
+        m_stars.add(s.x, s.y, s.size, s.speed);
+    }
+    for (uint32_t k = 0; k < w.particleCount; k++, p += sizeof(ParticleState))
+    {
+        ParticleState s;
+        memcpy(&s, p, sizeof(s));
+        m_explosions.add(Particle{s.x, s.y, s.vx, s.vy, s.size, s.growth, s.life});
+    }
+    m_rng.setState(w.rng);
+    m_tick = w.tick;
+    m_nextSpawnSeq = (unsigned long)w.nextSpawnSeq;
+    restoreProgress(w.score, w.lives, w.level);
+    m_aliensDestroyed = w.aliensDestroyed;
+    updateDisplayText();
+}
+
+bool StudentWorld::startRecording(const string& path)
+{
+    stopRecording();
+    m_recorder = new ReplayWriter;
+    if (!m_recorder->open(path, getSeed()))
+    {
+        delete m_recorder;
+        m_recorder = nullptr;
+        return false;
+    }
+    m_keyframeDue = (m_nb == nullptr); //at the next init...
+    if (!m_keyframeDue) //...or right now, mid-game
+    {
+        saveSnapshot(m_snapshot);
+        m_recorder->keyframe(m_tick, m_snapshot);
+        m_lastKeyframe = m_tick;
+    }
+    return true;
+}
+
+void StudentWorld::stopRecording()
+{
+    if (m_recorder == nullptr)
+        return;
+    m_recorder->close(m_tick);
+    delete m_recorder;
+    m_recorder = nullptr;
+}
+
+void StudentWorld::dumpProfile(ostream& out) const
+{
+#ifdef NB_PROFILE
+    m_profiler.dump(out);
+#else
+    out << "not profiled: build with NB_PROFILE defined" << endl;
+#endif
+}
+
+bool StudentWorld::lastTickProfile(uint32_t ns[NUM_PROF_PHASES]) const
+{
+#ifdef NB_PROFILE
+    m_profiler.lastTick(ns);
+    return true;
+#else
+    (void)ns; //nothing to fill in
+    return false;
+#endif
+}
+
+void StudentWorld::setStress(const StressSettings& stress) {m_stress = stress;}
+
+bool StudentWorld::getPlayerKey(int& value)
+{
+    if (!getKey(value))
+        return false;
+    if (m_recorder != nullptr)
+        m_recorder->input(m_tick, value);
+    return true;
+}
+
+Actor* StudentWorld::createActor(const ActorState& s) //an actor of the saved kind, to load s into
+{
+    switch (s.archetype) {
+        case ARCH_SMALLGON:
+            return m_pools.create<Smallgon>(s.x, s.y, getLevel(), this);
+        case ARCH_SMOREGON:
+            return m_pools.create<Smoregon>(s.x, s.y, getLevel(), this);
+        case ARCH_SNAGGLEGON:
+            return m_pools.create<Snagglegon>(s.x, s.y, getLevel(), this);
+        case ARCH_CABBAGE:
+            return m_pools.create<Cabbage>(s.x, s.y, this);
+        case ARCH_TURNIP:
+            return m_pools.create<Turnip>(s.x, s.y, this);
+        case ARCH_TORPEDO:
+            return m_pools.create<Torpedo>(s.x, s.y, this, s.tag);
+        case ARCH_REPAIR:
+            return m_pools.create<Repair>(s.x, s.y, this);
+        case ARCH_EXTRA_LIFE:
+            return m_pools.create<ExtraLife>(s.x, s.y, this);
+        default:
+            return m_pools.create<TorpedoGoodie>(s.x, s.y, this);
+    }
+}
+
+void StudentWorld::removeDeadGameObjects()
+{
+    m_actors.removeDead([this](Actor* ap) {
+        if (m_useSweep)
+            m_sweep.remove(ap);
+        else
+            m_grid.remove(ap);
+        m_handles.remove(ap->getHandle()); //anything still holding its handle now gets nullptr
+        m_pools.destroy(ap);
+    });
+    m_sweep.compact();
 }
 
-void StudentWorld::updateDisplayText() //sets display text
+void StudentWorld::updateDisplayText() //sets display text, if anything on it changed
 {
-    ostringstream oss; //setw attachs to the one after
-    oss.setf(ios::fixed);
-    oss.precision(0);
-    oss << "Lives: " << getLives() << setw(10) << "Health: " << m_nb->getHitPts()/50.0 * 100 << "%" << setw(9) << "Score: " << getScore() << setw(9) << "Level: " << getLevel() << setw(12) << "Cabbages: " << m_nb->getCabbages()/30.0 * 100 << "%" << setw(13) << "Torpedoes: " << m_nb->getTorpedoes();
-    setGameStatText(oss.str());
+    HudState s;
+    s.lives = getLives();
+    s.health = (int)lround(m_nb->getHitPts()/PLAYER_MAX_HIT_POINTS * 100);
+    s.score = getScore();
+    s.level = getLevel();
+    s.cabbages = (int)lround(m_nb->getCabbages()/(double)PLAYER_MAX_CABBAGES * 100);
+    s.torpedoes = m_nb->getTorpedoes();
+    if (m_hud.update(s))
+        setGameStatText(m_hud.text());
 }
 
-void StudentWorld::incDestroyedAliens()
+void StudentWorld::incDestroyedAliens() {m_commands.push(CMD_ALIEN_DESTROYED, 0);}
+void StudentWorld::queueDamage(ActorHandle target, int enemy) {m_commands.push(CMD_DAMAGE, enemy, 0, 0, target);}
+void StudentWorld::queueScore(int points) {m_commands.push(CMD_SCORE, points);}
+void StudentWorld::queueSound(int soundID) {m_commands.push(CMD_SOUND, soundID);}
+void StudentWorld::queueGoodie(int goodie) {m_commands.push(CMD_GOODIE, goodie);}
+
+void StudentWorld::applyCommands() //in the order they were queued, including any queued along the way
 {
-    m_aliensDestroyed++;
+    for (size_t k = 0; k < m_commands.size(); k++)
+    {
+        const Command c = m_commands[k];
+        switch (c.type)
+        {
+            case CMD_SPAWN_PROJECTILE:
+                spawnProjectile(c.x, c.y, c.value);
+                break;
+            case CMD_SPAWN_EXPLOSION:
+                m_explosions.explosion(c.x, c.y, EXPLOSION_SPARKS);
+                break;
+            case CMD_SPAWN_GOODIE:
+                spawnGoodieMaybe(c.x, c.y, c.value);
+                break;
+            case CMD_DAMAGE:
+            {
+                Actor* target = m_handles.get(c.target);
+                if (target == nullptr) //removed since the damage was queued
+                    break;
+                if (target == m_nb && m_stress.invulnerable)
+                    break;
+                if (target->isAlive()) //an actor killed earlier this tick can't be killed (or scored) twice
+                    target->sufferDamage(c.value);
+                break;
+            }
+            case CMD_SCORE:
+                increaseScore(c.value);
+                break;
+            case CMD_SOUND:
+                playSound(c.value);
+                break;
+            case CMD_ALIEN_DESTROYED:
+                m_aliensDestroyed++;
+                break;
+            case CMD_GOODIE: //gives different benefits to player depending on identity of goodie
+            {
+                const GoodieKind& g = goodieKind(c.value);
+                m_nb->increaseHitPts(g.health);
+                for (int life = 0; life < g.lives; life++)
+                    incLives();
+                m_nb->incTorpedo(g.torpedoes);
+                break;
+            }
+        }
+    }
+    m_commands.clear();
+}
+
+void StudentWorld::discardCommands() {m_commands.clear();}
+
+void StudentWorld::clearEffects() {m_explosions.clear();}
+
+template<typename Func>
+void StudentWorld::forEachNear(double x, double y, double reach, Func f) const
+{
+    if (m_useSweep)
+        m_sweep.forEachNear(x, y, reach, f);
+    else
+        m_grid.forEachNear(x, y, reach, f);
 }
 
 bool StudentWorld::processCollision(Actor* a2) //process a collision from another actor
 {
-    if (m_nb->isCollidable(a2->getTag()) && m_nb->collision(a2)) //checks collision with a2
+    if (m_nb->canBeHitBy(a2) && m_nb->collision(a2)) //checks collision with a2
     {
-        m_nb->sufferDamage(a2->getTag()); //player will suffer damage from a2
+        queueDamage(m_nb->getHandle(), a2->getTag()); //player will suffer damage from a2
         return true;
     }
-    list<Actor*>::iterator itr;
-    itr = m_actors.begin();
-    while (itr != m_actors.end())
+    //only actors in nearby grid cells can be touching a2: pack the ones a2 is
+    //able to hit and test them all at once
+    const double x = a2->getX();
+    const double y = a2->getY();
+    const double r = a2->getRadius();
+    const double reach = .75 * (r + (m_useSweep ? m_sweep.getMaxRadius() : m_grid.getMaxRadius()));
+    m_candidates.clear();
+    forEachNear(x, y, reach, [&](Actor* ap, unsigned long seq) {
+        if (ap->canBeHitBy(a2))
+            m_candidates.add(ap, seq);
+    });
+    
+    //of the candidates touching a2, the earliest spawned one is hit, as if the whole list had been scanned
+    Actor* hit = nullptr;
+    unsigned long hitSeq = 0;
+    const size_t n = m_candidates.size();
+    for (size_t base = 0; base < n; base += 64)
     {
-        Actor* ap = *itr;
-        if (ap->isCollidable(a2->getTag()) && ap->collision(a2)) //checks collision with a2
+        const int count = (n - base < 64) ? (int)(n - base) : 64;
+        uint64_t mask = circleHitMask(a2->getFixedX(), a2->getFixedY(), a2->getFixedRadius(), &m_candidates.x[base], &m_candidates.y[base], &m_candidates.radius[base], count);
+        for (size_t k = base; mask != 0; k++, mask >>= 1)
         {
-            ap->sufferDamage(a2->getTag()); //this actor will suffer damage from a2
-            return true;
+            if ((mask & 1) && (hit == nullptr || m_candidates.seq[k] < hitSeq))
+            {
+                hit = m_candidates.actor[k];
+                hitSeq = m_candidates.seq[k];
+            }
         }
-        itr++;
+    }
+    if (hit != nullptr)
+    {
+        queueDamage(hit->getHandle(), a2->getTag()); //this actor will suffer damage from a2
+        return true;
     }
     return false;
 }
 
-bool StudentWorld::completedLevel() const
+void StudentWorld::actorChanged(Actor* a)
 {
-    return 6 + (4 * getLevel()) == m_aliensDestroyed;
+    m_actors.sync(a);
+    if (m_useSweep)
+        m_sweep.update(a);
+    else
+        m_grid.update(a);
 }
 
-NachenBlaster* StudentWorld::getNB() const {return m_nb;}
+void StudentWorld::useSweepAndPrune(bool sweep) {m_useSweep = sweep;}
 
-void StudentWorld::addExplosion(double startX, double startY)
+bool StudentWorld::completedLevel() const
 {
-    m_actors.push_back(new Explosion(startX,startY));
+    if (m_stress.endless)
+        return false;
+    return 6 + (4 * getLevel()) == m_aliensDestroyed;
 }
 
-void StudentWorld::addGoodieMaybe(double startX, double startY, int tag) //add goodie based on tag
+ActorHandle StudentWorld::getPlayer() const {return (m_nb != nullptr) ? m_nb->getHandle() : NO_ACTOR;}
+Actor* StudentWorld::getActor(ActorHandle h) const {return m_handles.get(h);}
+const ActorStore& StudentWorld::getActors() const {return m_actors;}
+
+//Every random draw in the world goes through its own generator
+int StudentWorld::randInt(int min, int max) {return m_rng.randInt(min, max);}
+double StudentWorld::randDouble(double min, double max) {return m_rng.randDouble(min, max);}
+unsigned long StudentWorld::getSeed() const {return (unsigned long)m_rng.getSeed();}
+
+void StudentWorld::addExplosion(double startX, double startY) {m_commands.push(CMD_SPAWN_EXPLOSION, 0, startX, startY);}
+void StudentWorld::addGoodieMaybe(double startX, double startY, int drop) {m_commands.push(CMD_SPAWN_GOODIE, drop, startX, startY);}
+void StudentWorld::addProjectile(double startX, double startY, int tag) {m_commands.push(CMD_SPAWN_PROJECTILE, tag, startX, startY);}
+
+void StudentWorld::spawnGoodieMaybe(double startX, double startY, int drop) //add goodie by its DROP_* rule (GameRules.h)
 {
-    const int rLife = randInt(0, 5); //1/6 chance
-    if (tag == IID_LIFE_GOODIE) {
-        if (rLife < 1)
-            m_actors.push_back(new ExtraLife(startX, startY, this));
-        return;
-    }
-    
-    const int r = randInt(0, 2); //1/3 chance
-    if (r < 1)
+    const DropRule& d = DROP_RULES[drop];
+    if (randInt(0, d.odds-1) < 1) //1/odds chance
     {
-        const int r2 = randInt(0, 1); //1/2 chance
-        if (r2 < 1)
-            m_actors.push_back(new Repair(startX, startY, this));
-        else
-            m_actors.push_back(new TorpedoGoodie(startX, startY, this));
+        const int pick = (d.count > 1) ? randInt(0, d.count-1) : 0; //then an even chance of each goodie
+        ActorState s = {};
+        s.x = startX;
+        s.y = startY;
+        s.archetype = d.goodies[pick];
+        addActor(createActor(s));
     }
 }
 
-void StudentWorld::addProjectile(double startX, double startY, int tag) //add projectile based on tag
+void StudentWorld::spawnProjectile(double startX, double startY, int tag) //add projectile based on tag
 {
+    if (m_stress.maxProjectiles > 0 && (tag == IID_TURNIP || tag == ALIEN_TORPEDO) && currentProjectiles() >= m_stress.maxProjectiles)
+        return;
     switch (tag) {
         case IID_CABBAGE:
-            m_actors.push_back(new Cabbage(startX, startY, this));
+            addActor(m_pools.create<Cabbage>(startX, startY, this));
             break;
         case IID_TURNIP:
-            m_actors.push_back(new Turnip(startX, startY, this));
+            addActor(m_pools.create<Turnip>(startX, startY, this));
             break;
         case PLAYER_TORPEDO:
-            m_actors.push_back(new Torpedo(startX, startY, this, tag));
+            addActor(m_pools.create<Torpedo>(startX, startY, this, tag));
             break;
         case ALIEN_TORPEDO:
-            m_actors.push_back(new Torpedo(startX, startY, this, tag));
+            addActor(m_pools.create<Torpedo>(startX, startY, this, tag));
             break;
     }
 }
@@ -2,39 +2,126 @@
 #define STUDENTWORLD_H_
 
 #include "GameWorld.h"
+#include "RandomGenerator.h"
+#include "CollisionGrid.h"
+#include "SweepAndPrune.h"
+#include "ActorStore.h"
+#include "AlienKernels.h"
+#include "ActorPools.h"
+#include "CommandBuffer.h"
+#include "WorkerPool.h"
+#include "RewindBuffer.h"
+#include "ReplayWriter.h"
+#include "TickProfiler.h"
+#include "StressSettings.h"
+#include "HudText.h"
+#include "StarField.h"
+#include "VfxSystem.h"
 #include <string>
-#include <list>
+#include <iosfwd>
+#include <utility>
+#include <vector>
 
-double randDouble (double min, double max);
-
-class Actor;
 class NachenBlaster;
 
 class StudentWorld : public GameWorld
 {
 public:
     StudentWorld(std::string assetDir);
+    StudentWorld(std::string assetDir, unsigned long seed);
     virtual ~StudentWorld();
     virtual int init();
     virtual int move();
     virtual void cleanUp();
+    virtual bool rewind(int ticks); //back to the state after the tick `ticks` ticks ago, within this life, and the recording with it
+    unsigned long long getTick() const; //ticks moved since the game started
+    void saveSnapshot(std::vector<unsigned char>& out) const; //the whole world, between ticks (WorldSnapshot.h)
+    void loadSnapshot(const std::vector<unsigned char>& in); //replaces the world, and starts its rewind history over
+    bool startRecording(const std::string& path); //records this game's inputs and keyframes (ReplayFormat.h)
+    void stopRecording();
+    bool getPlayerKey(int& value); //the key the player pressed this tick, if any
+    void dumpProfile(std::ostream& out) const; //time spent per phase of move(), if built with NB_PROFILE
+    bool lastTickProfile(uint32_t ns[NUM_PROF_PHASES]) const; //the last move()'s phases, or false if not profiled
+    void setStress(const StressSettings& stress); //raised caps and rates for stress runs; not saved in snapshots
     void removeDeadGameObjects();
     void updateDisplayText();
     bool processCollision(Actor* a2);
-    void incDestroyedAliens();
+    void actorChanged(Actor* a);
     bool completedLevel() const;
+    //Effects of actors on the rest of the world are queued while actors update
+    //and applied together at the end of the tick (see CommandBuffer.h)
+    void incDestroyedAliens();
     void addExplosion(double startX, double startY);
-    void addGoodieMaybe(double startX, double startY, int tag);
+    void addGoodieMaybe(double startX, double startY, int drop);
     void addProjectile(double startX, double startY, int tag);
-    NachenBlaster* getNB() const;
+    void queueDamage(ActorHandle target, int enemy);
+    void queueScore(int points);
+    void queueSound(int soundID);
+    void queueGoodie(int goodie);
+    ActorHandle getPlayer() const;
+    Actor* getActor(ActorHandle h) const; //nullptr once the actor is gone
+    int randInt(int min, int max);
+    double randDouble(double min, double max);
+    unsigned long getSeed() const;
+    void useSweepAndPrune(bool sweep); //pick the collision broadphase; call before init()
+    void setWorkerThreads(int threads); //threads that share the planning phase of each tick; 1 plans serially
+    //For benchmark fixtures: place actors directly, and apply or drop queued effects outside move()
+    Actor* spawnActor(int archetype, double x, double y); //torpedoes spawned this way are the player's
+    void applyCommands(); //move() calls this once per tick
+    void discardCommands();
+    void clearEffects(); //explosions on screen
+    const ActorStore& getActors() const; //every actor but the player
 
 private:
-    std::list<Actor*> m_actors;
+    ActorStore m_actors; //every actor but the player
+    ActorPools m_pools; //where every actor in m_actors lives
+    ActorHandles m_handles; //handles of every actor, the player included
+    StarField m_stars; //the background stars, which aren't actors
+    VfxSystem m_explosions; //nor are explosions
+    CollisionGrid m_grid; //actors in m_actors that something can hit...
+    SweepAndPrune m_sweep; //...or the same actors sorted by x, if m_useSweep
+    bool m_useSweep;
+    CollisionCandidates m_candidates; //scratch space for processCollision
+    CommandBuffer m_commands; //this tick's queued effects
     NachenBlaster* m_nb;
     int m_aliensDestroyed;
-    int m_currAliens;
+    RandomGenerator m_rng;
+    WorkerPool* m_workers; //nullptr when planning serially
+    RewindBuffer m_history; //a snapshot after every tick of the current life
+    unsigned long long m_tick;
+    unsigned long m_nextSpawnSeq;
+    ReplayWriter* m_recorder; //nullptr when not recording
+    unsigned long long m_lastKeyframe; //tick of the last keyframe recorded
+    bool m_keyframeDue;
+    StressSettings m_stress;
+    HudText m_hud; //the status line, reformatted only when it changes
+#ifdef NB_PROFILE
+    TickProfiler m_profiler;
+#endif
+    std::vector<unsigned char> m_snapshot; //scratch
+    static const size_t MIN_PARALLEL_PLANS = 256; //fewer aliens than this plan faster on one thread
+    static const int EXPLOSION_SPARKS = 0; //particles flung out of each explosion besides the blast; the original look has none
     bool canAddAlien() const;
+    int currentAliens() const;
+    int currentProjectiles() const;
     void addSomeAlien();
+    void addActor(Actor* a);
+    void addStar(double x, double y);
+    void trackActor(Actor* a);
+    void applySnapshot(const std::vector<unsigned char>& in);
+    Actor* createActor(const ActorState& s);
+    void removeAllActors();
+    size_t snapshotSize() const; //bytes saveSnapshot() would write
+    void captureSnapshot();
+    void planActors();
+    void spawnGoodieMaybe(double startX, double startY, int drop);
+    void spawnProjectile(double startX, double startY, int tag);
+    template<typename Func>
+    void forEachNear(double x, double y, double reach, Func f) const;
+    template<int archetype>
+    void updateGroup();
+    template<size_t... archetypes>
+    void updateGroups(std::index_sequence<archetypes...>);
 };
 
 #endif // STUDENTWORLD_H_
@@ -0,0 +1,100 @@
+#include "SweepAndPrune.h"
+#include "Actor.h"
+using namespace std;
+
+SweepAndPrune::SweepAndPrune()
+: m_maxRadius(0), m_hasHoles(false)
+{}
+
+void SweepAndPrune::insert(Actor* a)
+{
+    m_entries.push_back(Entry{a->getX(), a->getY(), a, a->getSpawnSeq()});
+    a->setBroadphaseSlot((int)m_entries.size() - 1);
+    if (a->getRadius() > m_maxRadius)
+        m_maxRadius = a->getRadius();
+    sift(m_entries.size() - 1);
+}
+
+void SweepAndPrune::remove(Actor* a)
+{
+    const int k = a->getBroadphaseSlot();
+    if (k < 0) return;
+    m_entries[k].actor = nullptr; //keeps its x, so the order still holds
+    m_hasHoles = true;
+    a->setBroadphaseSlot(-1);
+}
+
+void SweepAndPrune::update(Actor* a)
+{
+    const int k = a->getBroadphaseSlot();
+    if (k < 0) return;
+    Entry& e = m_entries[k];
+    e.x = a->getX();
+    e.y = a->getY();
+    sift(k);
+}
+
+void SweepAndPrune::compact()
+{
+    if (!m_hasHoles) return;
+    size_t kept = 0;
+    for (size_t k = 0; k < m_entries.size(); k++)
+    {
+        if (m_entries[k].actor == nullptr)
+            continue;
+        m_entries[kept] = m_entries[k];
+        m_entries[kept].actor->setBroadphaseSlot((int)kept);
+        kept++;
+    }
+    m_entries.resize(kept);
+    m_hasHoles = false;
+}
+
+void SweepAndPrune::clear()
+{
+    for (Entry& e : m_entries)
+        if (e.actor != nullptr)
+            e.actor->setBroadphaseSlot(-1);
+    m_entries.clear(); //keeps capacity for the next level
+    m_maxRadius = 0;
+    m_hasHoles = false;
+}
+
+double SweepAndPrune::getMaxRadius() const {return m_maxRadius;}
+
+size_t SweepAndPrune::firstAtOrAfter(double x) const //binary search
+{
+    size_t lo = 0, hi = m_entries.size();
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        if (m_entries[mid].x < x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void SweepAndPrune::swapEntries(size_t i, size_t j)
+{
+    Entry tmp = m_entries[i];
+    m_entries[i] = m_entries[j];
+    m_entries[j] = tmp;
+    if (m_entries[i].actor != nullptr) m_entries[i].actor->setBroadphaseSlot((int)i);
+    if (m_entries[j].actor != nullptr) m_entries[j].actor->setBroadphaseSlot((int)j);
+}
+
+void SweepAndPrune::sift(size_t k) //moves entry k left or right until the order holds again
+{
+    while (k > 0 && m_entries[k-1].x > m_entries[k].x)
+    {
+        swapEntries(k-1, k);
+        k--;
+    }
+    while (k + 1 < m_entries.size() && m_entries[k+1].x < m_entries[k].x)
+    {
+        swapEntries(k, k+1);
+        k++;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef SWEEPANDPRUNE_H_
+#define SWEEPANDPRUNE_H_
+
+#include <cstddef>
+#include <vector>
+
+class Actor;
+
+//Sweep-and-prune broadphase: actors kept sorted by x.  Nearly everything in
+//the game moves a few pixels a tick, so after a move an actor only has to
+//swap past a neighbor or two to restore the order (insertion sort).
+//Has the same interface as CollisionGrid, so StudentWorld can use either.
+//Removed actors leave a hole that compact() squeezes out once a tick.
+class SweepAndPrune
+{
+public:
+    SweepAndPrune();
+    void insert(Actor* a);
+    void remove(Actor* a);
+    void update(Actor* a); //call after a moves
+    void compact();
+    void clear();
+    double getMaxRadius() const;
+
+    //Calls f(actor, seq) for every actor whose center is within reach of (x, y) on both axes
+    template<typename Func>
+    void forEachNear(double x, double y, double reach, Func f) const
+    {
+        for (size_t k = firstAtOrAfter(x - reach); k < m_entries.size() && m_entries[k].x <= x + reach; k++)
+        {
+            const Entry& e = m_entries[k];
+            if (e.actor != nullptr && e.y >= y - reach && e.y <= y + reach)
+                f(e.actor, e.seq);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        double x;
+        double y;
+        Actor* actor; //nullptr once removed, until compact()
+        unsigned long seq;
+    };
+    std::vector<Entry> m_entries; //sorted by x
+    double m_maxRadius;
+    bool m_hasHoles;
+
+    size_t firstAtOrAfter(double x) const;
+    void swapEntries(size_t i, size_t j);
+    void sift(size_t k);
+};
+
+#endif // SWEEPANDPRUNE_H_
@@ -0,0 +1,97 @@
+#include "TickProfiler.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+using namespace std;
+
+static const char* const PHASE_NAMES[NUM_PROF_PHASES] = {
+    "player", "plan", "stars", "smallgons", "smoregons", "snagglegons", "projectiles",
+    "goodies", "explosions", "commands", "removeDead", "displayText", "spawnStar",
+    "spawnAlien", "snapshot"
+};
+
+const char* profilePhaseName(int phase) {return PHASE_NAMES[phase];}
+
+TickProfiler::TickProfiler()
+: m_written(0)
+{
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+        m_current[p] = 0;
+}
+
+void TickProfiler::beginTick()
+{
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+        m_current[p] = 0;
+    m_last = chrono::steady_clock::now();
+}
+
+void TickProfiler::lap(int phase)
+{
+    const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    m_current[phase] += (uint32_t)chrono::duration_cast<chrono::nanoseconds>(now - m_last).count();
+    m_last = now;
+}
+
+void TickProfiler::endTick()
+{
+    const unsigned long long n = m_written.load(memory_order_relaxed);
+    TickTimes& t = m_ring[n % RING_TICKS];
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+        t.ns[p].store(m_current[p], memory_order_relaxed);
+    m_written.store(n + 1, memory_order_release);
+}
+
+void TickProfiler::lastTick(uint32_t ns[NUM_PROF_PHASES]) const
+{
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+        ns[p] = m_current[p];
+}
+
+void TickProfiler::dump(ostream& out) const
+{
+    //copy first, then check how far the writer got meanwhile
+    vector<array<uint32_t, NUM_PROF_PHASES>> copy(RING_TICKS);
+    const unsigned long long end = m_written.load(memory_order_acquire);
+    const unsigned long long begin = (end > RING_TICKS) ? end - RING_TICKS : 0;
+    for (unsigned long long k = begin; k < end; k++)
+        for (int p = 0; p < NUM_PROF_PHASES; p++)
+            copy[k % RING_TICKS][p] = m_ring[k % RING_TICKS].ns[p].load(memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    const unsigned long long after = m_written.load(memory_order_relaxed);
+    const unsigned long long first = (after >= RING_TICKS && after - RING_TICKS + 1 > begin) ? after - RING_TICKS + 1 : begin;
+    
+    double mean[NUM_PROF_PHASES];
+    uint32_t max[NUM_PROF_PHASES];
+    double total = 0;
+    const unsigned long long ticks = (end > first) ? end - first : 0;
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+    {
+        double sum = 0;
+        max[p] = 0;
+        for (unsigned long long k = first; k < end; k++)
+        {
+            const uint32_t ns = copy[k % RING_TICKS][p];
+            sum += ns;
+            if (ns > max[p])
+                max[p] = ns;
+        }
+        mean[p] = (ticks > 0) ? sum / ticks : 0;
+        total += mean[p];
+    }
+    
+    const ios::fmtflags flags = out.flags();
+    const streamsize precision = out.precision();
+    out << "profile of the last " << ticks << " ticks (microseconds)" << endl;
+    out << left << setw(14) << "phase" << right << setw(10) << "mean" << setw(10) << "max" << setw(9) << "share" << endl;
+    out.setf(ios::fixed);
+    for (int p = 0; p < NUM_PROF_PHASES; p++)
+    {
+        out << left << setw(14) << PHASE_NAMES[p] << right << setprecision(3) << setw(10) << mean[p] / 1000
+            << setw(10) << max[p] / 1000.0 << setprecision(1) << setw(8) << (total > 0 ? 100 * mean[p] / total : 0) << "%" << endl;
+    }
+    out << left << setw(14) << "tick" << right << setprecision(3) << setw(10) << total / 1000 << endl;
+    out.flags(flags);
+    out.precision(precision);
+}
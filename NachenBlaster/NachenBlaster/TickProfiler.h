@@ -0,0 +1,69 @@
+#ifndef TICKPROFILER_H_
+#define TICKPROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+//Phases of StudentWorld::move that the profiler times separately
+const int PROF_PLAYER        = 0;
+const int PROF_PLAN          = 1;
+const int PROF_STARS         = 2;
+const int PROF_SMALLGONS     = 3;
+const int PROF_SMOREGONS     = 4;
+const int PROF_SNAGGLEGONS   = 5;
+const int PROF_PROJECTILES   = 6;
+const int PROF_GOODIES       = 7;
+const int PROF_EXPLOSIONS    = 8;
+const int PROF_COMMANDS      = 9;
+const int PROF_REMOVE_DEAD   = 10;
+const int PROF_DISPLAY_TEXT  = 11;
+const int PROF_SPAWN_STAR    = 12;
+const int PROF_SPAWN_ALIEN   = 13;
+const int PROF_SNAPSHOT      = 14;
+const int NUM_PROF_PHASES    = 15;
+
+const char* profilePhaseName(int phase);
+
+//Times the phases of each tick with steady_clock and keeps the last
+//RING_TICKS ticks in a ring.  Only the simulation thread writes; dump() may
+//run on any thread at any time without locking: it copies the ring and keeps
+//only the entries the writer can't have touched while it was copying.
+//StudentWorld only has one when built with NB_PROFILE defined; otherwise the
+//PROFILE_ macros below compile to nothing.
+class TickProfiler
+{
+public:
+    static const unsigned long long RING_TICKS = 1024;
+
+    TickProfiler();
+    void beginTick();
+    void lap(int phase); //charges the time since the last lap (or beginTick) to phase
+    void endTick();
+    void dump(std::ostream& out) const; //per-phase mean and max over the ticks in the ring
+    void lastTick(uint32_t ns[NUM_PROF_PHASES]) const; //the tick just ended; simulation thread only
+
+private:
+    struct TickTimes
+    {
+        std::atomic<uint32_t> ns[NUM_PROF_PHASES];
+    };
+
+    TickTimes m_ring[RING_TICKS];
+    std::atomic<unsigned long long> m_written; //ticks ever published
+    uint32_t m_current[NUM_PROF_PHASES];
+    std::chrono::steady_clock::time_point m_last;
+};
+
+#ifdef NB_PROFILE
+#define PROFILE_BEGIN_TICK(profiler)        (profiler).beginTick()
+#define PROFILE_LAP(profiler, phase)        (profiler).lap(phase)
+#define PROFILE_END_TICK(profiler)          (profiler).endTick()
+#else
+#define PROFILE_BEGIN_TICK(profiler)        ((void)0)
+#define PROFILE_LAP(profiler, phase)        ((void)0)
+#define PROFILE_END_TICK(profiler)          ((void)0)
+#endif
+
+#endif // TICKPROFILER_H_
@@ -0,0 +1,140 @@
+#include "VfxSystem.h"
+#include <math.h>
+using namespace std;
+
+//An explosion's blast starts at 1.5, grows by half every tick and is drawn 3 times, like
+//the Explosion actor it replaced; its sparks are smaller and fly outward
+static const Particle BLAST = {0, 0, 0, 0, 1.5, 1.5, 3};
+static const double PI = 4 * atan(1.0);
+static const double SPARK_SPEED = 2;
+static const double SPARK_SIZE = .4;
+static const double SPARK_GROWTH = 1.2;
+
+VfxSystem::VfxSystem(GraphObjectRegistry& registry, int imageID)
+: m_registry(registry), m_x(CAPACITY), m_y(CAPACITY), m_vx(CAPACITY), m_vy(CAPACITY),
+  m_size(CAPACITY), m_growth(CAPACITY), m_life(CAPACITY), m_drawnAt(CAPACITY), m_first(0), m_count(0)
+{
+    m_batch.imageID = imageID;
+    m_batch.x.reserve(CAPACITY); //so the batch never reallocates either
+    m_batch.y.reserve(CAPACITY);
+    m_batch.size.reserve(CAPACITY);
+    m_registry.addBatch(&m_batch, DEPTH);
+}
+
+VfxSystem::~VfxSystem()
+{
+    m_registry.removeBatch(&m_batch);
+}
+
+void VfxSystem::add(const Particle& p)
+{
+    const bool full = (m_count == CAPACITY);
+    if (full) //the oldest particle gives way
+    {
+        m_first = (m_first + 1) % CAPACITY;
+        m_count--;
+    }
+    const size_t k = (m_first + m_count) % CAPACITY;
+    m_x[k] = p.x;
+    m_y[k] = p.y;
+    m_vx[k] = p.vx;
+    m_vy[k] = p.vy;
+    m_size[k] = p.size;
+    m_growth[k] = p.growth;
+    m_life[k] = p.life;
+    m_count++;
+    if (full && m_drawnAt[k] != NOT_DRAWN) //k is the slot the oldest gave up: take its place in the batch too
+    {
+        const size_t b = m_drawnAt[k];
+        m_batch.x[b] = p.x;
+        m_batch.y[b] = p.y;
+        m_batch.size[b] = p.size;
+    }
+    else
+    {
+        m_drawnAt[k] = m_batch.x.size();
+        m_batch.x.push_back(p.x);
+        m_batch.y.push_back(p.y);
+        m_batch.size.push_back(p.size);
+    }
+}
+
+void VfxSystem::explosion(double x, double y, int sparks)
+{
+    Particle p = BLAST;
+    p.x = x;
+    p.y = y;
+    add(p);
+    for (int k = 0; k < sparks; k++) //evenly spread, so effects don't draw on the game's random numbers
+    {
+        const double angle = 2 * PI * k / sparks;
+        add(Particle{x, y, SPARK_SPEED * cos(angle), SPARK_SPEED * sin(angle), SPARK_SIZE, SPARK_GROWTH, BLAST.life});
+    }
+}
+
+void VfxSystem::updateRange(size_t begin, size_t end) //no branches or calls, so this vectorizes
+{
+    double* x = m_x.data();
+    double* y = m_y.data();
+    double* size = m_size.data();
+    int* life = m_life.data();
+    const double* vx = m_vx.data();
+    const double* vy = m_vy.data();
+    const double* growth = m_growth.data();
+    for (size_t k = begin; k < end; k++)
+    {
+        x[k] += vx[k];
+        y[k] += vy[k];
+        size[k] *= growth[k];
+        life[k]--;
+    }
+}
+
+void VfxSystem::update()
+{
+    const size_t end = m_first + m_count; //the live particles wrap around the end of the ring at most once
+    updateRange(m_first, (end < CAPACITY) ? end : CAPACITY);
+    if (end > CAPACITY)
+        updateRange(0, end - CAPACITY);
+    while (m_count > 0 && m_life[m_first] <= 0) //particles mostly expire oldest first
+    {
+        m_first = (m_first + 1) % CAPACITY;
+        m_count--;
+    }
+    rebuildBatch();
+}
+
+void VfxSystem::rebuildBatch() //live particles, oldest first until the ring fills
+{
+    m_batch.x.clear();
+    m_batch.y.clear();
+    m_batch.size.clear();
+    for (size_t n = 0; n < m_count; n++)
+    {
+        const size_t k = (m_first + n) % CAPACITY;
+        if (m_life[k] <= 0) //expired behind a longer-lived particle
+        {
+            m_drawnAt[k] = NOT_DRAWN;
+            continue;
+        }
+        m_drawnAt[k] = m_batch.x.size();
+        m_batch.x.push_back(m_x[k]);
+        m_batch.y.push_back(m_y[k]);
+        m_batch.size.push_back(m_size[k]);
+    }
+}
+
+void VfxSystem::clear()
+{
+    m_first = 0;
+    m_count = 0;
+    rebuildBatch();
+}
+
+size_t VfxSystem::size() const {return m_count;}
+
+Particle VfxSystem::get(size_t k) const
+{
+    k = (m_first + k) % CAPACITY;
+    return Particle{m_x[k], m_y[k], m_vx[k], m_vy[k], m_size[k], m_growth[k], m_life[k]};
+}
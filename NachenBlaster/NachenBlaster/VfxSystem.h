@@ -0,0 +1,61 @@
+#ifndef VFXSYSTEM_H_
+#define VFXSYSTEM_H_
+
+#include "GraphObject.h"
+#include <cstddef>
+#include <vector>
+
+//One particle of an effect: it drifts by (vx, vy) and its size is multiplied
+//by growth every tick, until its life runs out
+struct Particle
+{
+    double x;
+    double y;
+    double vx;
+    double vy;
+    double size;
+    double growth;
+    int life; //ticks left on screen, counting the one it spawned in
+};
+
+//Short-lived effects of one image, kept as particles in a fixed-capacity ring
+//of parallel arrays instead of as actors.  Spawning writes into the ring (the
+//oldest particle gives way if it's full), so effects never allocate, and a
+//tick is one loop over the live particles.  The live particles are copied into
+//a SpriteBatch in the world's registry, so the renderer draws them in one go.
+class VfxSystem
+{
+public:
+    static const size_t CAPACITY = 4096;
+    static const int DEPTH = 0;
+
+    VfxSystem(GraphObjectRegistry& registry, int imageID);
+    ~VfxSystem();
+    void add(const Particle& p);
+    void explosion(double x, double y, int sparks); //a growing blast, and sparks flung out of it
+    void update();
+    void clear();
+    size_t size() const;
+    Particle get(size_t k) const; //k = 0 is the oldest
+private:
+    static const size_t NOT_DRAWN = (size_t)-1;
+
+    GraphObjectRegistry& m_registry;
+    SpriteBatch m_batch;
+    std::vector<double> m_x; //all CAPACITY long, from the start
+    std::vector<double> m_y;
+    std::vector<double> m_vx;
+    std::vector<double> m_vy;
+    std::vector<double> m_size;
+    std::vector<double> m_growth;
+    std::vector<int> m_life;
+    std::vector<size_t> m_drawnAt; //where each live particle is in the batch, or NOT_DRAWN
+    size_t m_first; //slot of the oldest particle
+    size_t m_count;
+    void updateRange(size_t begin, size_t end);
+    void rebuildBatch();
+    VfxSystem(const VfxSystem&) = delete;
+    VfxSystem& operator=(const VfxSystem&) = delete;
+};
+
+#endif // VFXSYSTEM_H_
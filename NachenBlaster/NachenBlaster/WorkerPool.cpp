@@ -0,0 +1,78 @@
+#include "WorkerPool.h"
+#include <algorithm>
+using namespace std;
+
+WorkerPool::WorkerPool(int threads)
+: m_body(nullptr), m_count(0), m_chunk(1), m_next(0), m_busy(0), m_job(0), m_stop(false)
+{
+    for (int k = 1; k < threads; k++)
+        m_workers.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (thread& t : m_workers)
+        t.join();
+}
+
+int WorkerPool::threads() const {return (int)m_workers.size() + 1;}
+
+void WorkerPool::run(size_t count, const function<void(size_t, size_t)>& body)
+{
+    if (count == 0)
+        return;
+    if (m_workers.empty())
+    {
+        body(0, count);
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_body = &body;
+        m_count = count;
+        m_chunk = max<size_t>(1, count / (threads() * 4)); //a few chunks per thread evens out uneven work
+        m_next = 0;
+        m_busy = (int)m_workers.size();
+        m_job++;
+    }
+    m_wake.notify_all();
+    takeChunks();
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_body = nullptr;
+}
+
+void WorkerPool::takeChunks()
+{
+    for (;;)
+    {
+        const size_t begin = m_next.fetch_add(m_chunk);
+        if (begin >= m_count)
+            return;
+        (*m_body)(begin, min(begin + m_chunk, m_count));
+    }
+}
+
+void WorkerPool::work()
+{
+    unsigned long seen = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_job != seen; });
+            if (m_stop)
+                return;
+            seen = m_job;
+        }
+        takeChunks();
+        lock_guard<mutex> lock(m_mutex);
+        if (--m_busy == 0)
+            m_done.notify_one();
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef WORKERPOOL_H_
+#define WORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Fixed set of threads that split a range of indices between them.
+//run() hands out chunks of [0, count) until none are left and returns once
+//every chunk is done.  The calling thread takes chunks too, so a pool of
+//n threads only starts n-1 workers, and a pool of 1 just runs the body.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(int threads);
+    ~WorkerPool();
+    int threads() const;
+
+    //Calls body(begin, end) on disjoint chunks covering [0, count), in no particular order
+    void run(size_t count, const std::function<void(size_t, size_t)>& body);
+
+private:
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake; //a new job, or stop
+    std::condition_variable m_done; //the last worker finished its share
+    const std::function<void(size_t, size_t)>* m_body;
+    size_t m_count;
+    size_t m_chunk;
+    std::atomic<size_t> m_next; //first index not handed out yet
+    int m_busy; //workers still on the current job
+    unsigned long m_job; //bumped by every run()
+    bool m_stop;
+
+    void work();
+    void takeChunks();
+
+    // Prevent copying or assigning WorkerPools
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+};
+
+#endif // WORKERPOOL_H_
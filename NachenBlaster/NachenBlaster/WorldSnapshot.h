@@ -0,0 +1,71 @@
+#ifndef WORLDSNAPSHOT_H_
+#define WORLDSNAPSHOT_H_
+
+#include <cstdint>
+
+//What a snapshot keeps of one actor (see Actor::saveState).  Fixed size and
+//no padding, so snapshots of nearby ticks differ only where the game changed.
+struct ActorState
+{
+    double x;
+    double y;
+    double size;
+    double hitPts; //ships only
+    double speed; //aliens only
+    uint64_t spawnSeq;
+    int32_t archetype;
+    int32_t tag;
+    int32_t direction;
+    int32_t flight; //aliens only
+    int32_t travelDir; //aliens only
+    int32_t unused; //keeps the record the same size
+    int32_t cabbages; //player only
+    int32_t torpedoes; //player only
+};
+
+//What a snapshot keeps of one background star (see StarField.h)
+struct StarState
+{
+    double x;
+    double y;
+    double size;
+    double speed;
+};
+
+//What a snapshot keeps of one effect particle (see VfxSystem.h)
+struct ParticleState
+{
+    double x;
+    double y;
+    double vx;
+    double vy;
+    double size;
+    double growth;
+    int32_t life;
+    int32_t unused; //keeps the record 8-byte aligned
+};
+
+//A snapshot is one WorldState, then actorCount ActorStates in ActorStore order,
+//then starCount StarStates, then particleCount ParticleStates, oldest first
+struct WorldState
+{
+    uint64_t rng[4];
+    uint64_t tick;
+    uint64_t nextSpawnSeq;
+    uint32_t score;
+    uint32_t lives;
+    uint32_t level;
+    int32_t aliensDestroyed;
+    uint32_t actorCount;
+    uint32_t starCount;
+    uint32_t particleCount;
+    uint32_t unused; //keeps the player record 8-byte aligned
+    ActorState player;
+};
+
+static_assert(sizeof(ActorState) == 80, "ActorState must not have padding");
+static_assert(sizeof(StarState) == 32, "StarState must not have padding");
+static_assert(sizeof(ParticleState) == 56, "ParticleState must not have padding");
+static_assert(sizeof(WorldState) == 80 + sizeof(ActorState), "WorldState must not have padding");
+
+#endif // WORLDSNAPSHOT_H_
@@ -1,4 +1,7 @@
 #include "GameController.h"
+#include "StudentWorld.h"
+#include "ReplayReader.h"
+#include "ReplayController.h"
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -30,6 +33,43 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	  // -record FILE saves the game as a replay; -replay FILE plays one back
+	string recordPath;
+	string replayPath;
+	for (int k = 1; k + 1 < argc; k++)
+	{
+		if (string(argv[k]) == "-record")
+			recordPath = argv[k+1];
+		else if (string(argv[k]) == "-replay")
+			replayPath = argv[k+1];
+	}
+
+	if (!replayPath.empty())
+	{
+		ReplayReader replay;
+		if (!replay.open(replayPath))
+		{
+			cout << "Cannot read replay " << replayPath << endl;
+			return 1;
+		}
+		StudentWorld* sw = new StudentWorld(assetDirectory, replay.getSeed());
+		ReplayController input(replay, *sw, &Game());
+		Game().run(argc, argv, sw, "NachenBlaster (replay)", &input);
+		return 0;
+	}
+
+	if (!recordPath.empty())
+	{
+		StudentWorld* sw = new StudentWorld(assetDirectory);
+		if (!sw->startRecording(recordPath))
+		{
+			cout << "Cannot record to " << recordPath << endl;
+			return 1;
+		}
+		Game().run(argc, argv, sw, "NachenBlaster");
+		return 0;
+	}
+
 	GameWorld* gw = createStudentWorld(assetDirectory);
 	Game().run(argc, argv, gw, "NachenBlaster");
 }